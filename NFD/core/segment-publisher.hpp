@@ -72,7 +72,7 @@ public:
   void
   publish()
   {
-    ndn::EncodingBuffer buffer;
+    ndn::EncodingBuffer buffer(ndn::encoding::ReusableBufferTag{});
     generate(buffer);
 
     const uint8_t* rawBuffer = buffer.buf();
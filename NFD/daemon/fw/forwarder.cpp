@@ -395,9 +395,8 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
-  // - reduce amount of memory used by cached entries
-  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
+  // Remove ns-3 packet metadata (hop count) from the Data before inserting into cache, so Data
+  // served from the cache does not report the hop count of the original retrieval.
   //
   // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
   // pointing to the same underlying memory buffer.
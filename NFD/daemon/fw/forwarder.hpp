@@ -103,6 +103,9 @@ public: // forwarding entrypoints and tables
   Cfib&
   getSit();
 
+  NameTree&
+  getSitNameTree();
+
   Pit&
   getPit();
 
@@ -307,6 +310,12 @@ Forwarder::getSit()
   return m_sit;
 }
 
+inline NameTree&
+Forwarder::getSitNameTree()
+{
+  return m_nameTree_sit;
+}
+
 inline Pit&
 Forwarder::getPit()
 {
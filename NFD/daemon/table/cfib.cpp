@@ -44,6 +44,12 @@ Cfib::getCapacity()
   return m_limit;
 }
 
+size_t
+Cfib::getMemoryUsage() const
+{
+  return Fib::getMemoryUsage() + m_cache.getMemoryUsage(m_limit);
+}
+
 shared_ptr<fib::Entry>
 Cfib::findExactMatch(const Name& prefix)
 {
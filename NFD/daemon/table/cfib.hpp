@@ -3,6 +3,7 @@
 #define NFD_DAEMON_TABLE_CFIB_HPP
 
 #include "fib.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 
@@ -35,6 +36,10 @@ public:
   size_t
   getCapacity();
 
+  /// approximate number of bytes taken by SIT entries and the LRU cache
+  size_t
+  getMemoryUsage() const;
+
 private:
   template<class K, class T>
   struct LRUCacheEntry
@@ -155,6 +160,16 @@ private:
         return NULL;
     }
 
+    /// approximate number of bytes taken by the cache with capacity entries
+    size_t getMemoryUsage(size_t capacity) const
+    {
+      // note that get() and remove() also add null mappings for the names they do not find
+      return capacity * (sizeof(LRUCacheEntry<K,T>) + sizeof(LRUCacheEntry<K,T>*)) +
+             m_mapping.size() * (sizeof(std::pair<const K, LRUCacheEntry<K,T>*>) +
+                                 memory_usage::NODE_OVERHEAD) +
+             m_mapping.bucket_count() * sizeof(void*);
+    }
+
     private:
       void detach(LRUCacheEntry<K,T>* node)
       {
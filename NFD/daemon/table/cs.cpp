@@ -25,6 +25,7 @@
 
 #include "cs.hpp"
 #include "cs-policy-priority-fifo.hpp"
+#include "memory-usage.hpp"
 #include "core/logger.hpp"
 #include "core/algorithm.hpp"
 
@@ -50,7 +51,15 @@ makeDefaultPolicy()
   return unique_ptr<Policy>(new PriorityFifoPolicy());
 }
 
+// table entry with its node, the index node kept by the policy, and the Data
+static inline size_t
+estimateEntrySize(const Data& data)
+{
+  return sizeof(EntryImpl) + 3 * memory_usage::NODE_OVERHEAD + memory_usage::estimate(data);
+}
+
 Cs::Cs(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : m_nBytes(0)
 {
   this->setPolicyImpl(policy);
   m_policy->setLimit(nMaxPackets);
@@ -110,6 +119,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_nBytes += estimateEntrySize(data);
     m_policy->afterInsert(it);
   }
 
@@ -201,6 +211,7 @@ Cs::setPolicyImpl(unique_ptr<Policy>& policy)
 {
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      m_nBytes -= estimateEntrySize(it->getData());
       m_table.erase(it);
     });
 
@@ -127,6 +127,15 @@ public:
     return m_table.size();
   }
 
+  /** \return approximate number of bytes taken by stored packets and their entries
+   *  \sa memory_usage
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_nBytes;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
@@ -183,6 +192,7 @@ private: // find
 
 private:
   Table m_table;
+  size_t m_nBytes;
   unique_ptr<Policy> m_policy;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
 };
@@ -24,6 +24,7 @@
  */
 
 #include "dead-nonce-list.hpp"
+#include "memory-usage.hpp"
 #include "core/city-hash.hpp"
 #include "core/logger.hpp"
 
@@ -86,6 +87,14 @@ DeadNonceList::size() const
   return m_queue.size() - this->countMarks();
 }
 
+size_t
+DeadNonceList::getMemoryUsage() const
+{
+  // every node is linked into the sequenced index and the hashed index
+  return m_queue.size() * (sizeof(Entry) + 2 * memory_usage::NODE_OVERHEAD) +
+         m_ht.bucket_count() * sizeof(void*);
+}
+
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
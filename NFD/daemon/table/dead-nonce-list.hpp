@@ -83,6 +83,13 @@ public:
   size_t
   size() const;
 
+  /** \return approximate number of bytes taken by the index
+   *  \note All entries have the same size, so the value is derived from the index size.
+   *  \sa memory_usage
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   const time::nanoseconds&
@@ -31,6 +31,7 @@ namespace fib {
 
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_isShared(false)
 {
 }
 
@@ -31,6 +31,7 @@
 namespace nfd {
 
 class NameTree;
+class Fib;
 namespace name_tree {
 class Entry;
 }
@@ -74,6 +75,13 @@ public:
   bool
   hasNextHop(shared_ptr<Face> face) const;
 
+  /** \return whether this Entry is shared by several direct-indexed numeric prefixes;
+   *          getPrefix() of a shared Entry is the numeric root
+   *  \sa Fib::setNumericRoot
+   */
+  bool
+  isShared() const;
+
   /** \brief adds a NextHop record
    *
    *  If a NextHop record for face already exists, its cost is updated.
@@ -106,10 +114,12 @@ private:
 private:
   Name m_prefix;
   NextHopList m_nextHops;
+  bool m_isShared;
 
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Fib;
 };
 
 
@@ -131,6 +141,12 @@ Entry::hasNextHops() const
   return !m_nextHops.empty();
 }
 
+inline bool
+Entry::isShared() const
+{
+  return m_isShared;
+}
+
 } // namespace fib
 } // namespace nfd
 
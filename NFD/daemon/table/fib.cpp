@@ -26,6 +26,7 @@
 #include "fib.hpp"
 #include "pit-entry.hpp"
 #include "measurements-entry.hpp"
+#include "memory-usage.hpp"
 
 #include <boost/concept/assert.hpp>
 #include <boost/concept_check.hpp>
@@ -47,9 +48,19 @@ static_assert(std::is_default_constructible<Fib::const_iterator>::value,
 BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Fib::const_iterator>));
 #endif // HAVE_IS_DEFAULT_CONSTRUCTIBLE
 
+/** \brief largest number accepted as a direct index of a numeric prefix
+ *
+ *  Larger numbers are stored in the NameTree, so a stray name cannot make the array huge.
+ */
+static const uint64_t MAX_NUMERIC_INDEX = 1 << 24;
+
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_nBytes(0)
+  , m_hasNumericRoot(false)
+  , m_nNumericItems(0)
+  , m_nShadowingItems(0)
 {
 }
 
@@ -57,15 +68,204 @@ Fib::~Fib()
 {
 }
 
+// FIB entry with one nexthop
+static inline size_t
+estimateEntrySize(const Name& prefix)
+{
+  return sizeof(fib::Entry) + sizeof(fib::NextHop) + memory_usage::estimate(prefix);
+}
+
+size_t
+Fib::getMemoryUsage() const
+{
+  // numeric entries: array slots, entries shared by prefixes with the same nexthops, and
+  // (approximately) private entries that have been modified since the last lookup
+  size_t nNumericObjects = m_sharedNumericEntries.size() + m_dirtyNumericEntries.size();
+  return m_nBytes + m_numericEntries.capacity() * sizeof(shared_ptr<fib::Entry>) +
+         nNumericObjects * (estimateEntrySize(m_numericRoot) + memory_usage::NODE_OVERHEAD);
+}
+
 static inline bool
 predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
 {
   return static_cast<bool>(entry.getFibEntry());
 }
 
+bool
+Fib::getNumericIndex(const Name& name, bool isExact, size_t& index) const
+{
+  if (!m_hasNumericRoot)
+    return false;
+
+  size_t rootSize = m_numericRoot.size();
+  if (name.size() <= rootSize || (isExact && name.size() != rootSize + 1))
+    return false;
+
+  const Name::Component& component = name.get(rootSize);
+  if (!component.isNumber() || !m_numericRoot.isPrefixOf(name))
+    return false;
+
+  uint64_t number = component.toNumber();
+  if (number >= MAX_NUMERIC_INDEX)
+    return false;
+
+  index = static_cast<size_t>(number);
+  return true;
+}
+
+bool
+Fib::isShadowingNumeric(const Name& prefix) const
+{
+  size_t index;
+  return m_hasNumericRoot && prefix.size() > m_numericRoot.size() + 1 &&
+         this->getNumericIndex(prefix, false, index);
+}
+
+void
+Fib::setNumericRoot(const Name& root)
+{
+  if (m_hasNumericRoot) {
+    BOOST_ASSERT(m_numericRoot == root);
+    return;
+  }
+
+  m_hasNumericRoot = true;
+  m_numericRoot = root;
+
+  // move existing numeric entries out of the NameTree
+  std::list<shared_ptr<fib::Entry>> toMove;
+  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
+  for (const name_tree::Entry& nte : enumerable) {
+    shared_ptr<fib::Entry> entry = nte.getFibEntry();
+    size_t index;
+    if (this->getNumericIndex(entry->getPrefix(), true, index)) {
+      toMove.push_back(entry);
+    }
+    else if (this->isShadowingNumeric(entry->getPrefix())) {
+      ++m_nShadowingItems;
+    }
+  }
+
+  for (const shared_ptr<fib::Entry>& entry : toMove) {
+    this->erase(*entry);
+    shared_ptr<fib::Entry> numericEntry = this->insert(entry->getPrefix()).first;
+    numericEntry->m_nextHops = entry->m_nextHops;
+  }
+}
+
+size_t
+Fib::getNNumericEntryObjects() const
+{
+  this->compactNumericEntries();
+
+  std::set<const fib::Entry*> objects;
+  for (const shared_ptr<fib::Entry>& entry : m_numericEntries) {
+    if (entry != nullptr)
+      objects.insert(entry.get());
+  }
+  return objects.size();
+}
+
+shared_ptr<fib::Entry>&
+Fib::detachNumericEntry(size_t index) const
+{
+  shared_ptr<fib::Entry>& entry = m_numericEntries[index];
+  if (entry->isShared()) {
+    shared_ptr<fib::Entry> privateEntry =
+      make_shared<fib::Entry>(Name(m_numericRoot).appendNumber(index));
+    privateEntry->m_nextHops = entry->m_nextHops;
+    entry = privateEntry;
+  }
+  // caller may modify the entry, so it is compacted again on next lookup
+  m_dirtyNumericEntries.push_back(index);
+  return entry;
+}
+
+void
+Fib::compactNumericEntries() const
+{
+  if (m_dirtyNumericEntries.empty())
+    return;
+
+  for (size_t index : m_dirtyNumericEntries) {
+    if (index >= m_numericEntries.size())
+      continue;
+
+    shared_ptr<fib::Entry>& entry = m_numericEntries[index];
+    if (entry == nullptr || // erased
+        entry->isShared() ||
+        !entry->hasNextHops()) {
+      continue;
+    }
+
+    NextHopKey key;
+    key.reserve(entry->getNextHops().size());
+    for (const fib::NextHop& nexthop : entry->getNextHops()) {
+      key.push_back(std::make_pair(nexthop.getFace().get(), nexthop.getCost()));
+    }
+
+    shared_ptr<fib::Entry>& sharedEntry = m_sharedNumericEntries[key];
+    if (sharedEntry == nullptr) {
+      sharedEntry = make_shared<fib::Entry>(m_numericRoot);
+      sharedEntry->m_nextHops = entry->m_nextHops;
+      sharedEntry->m_isShared = true;
+    }
+    entry = sharedEntry;
+  }
+  m_dirtyNumericEntries.clear();
+
+  // release shared entries that are no longer used by any numeric prefix
+  for (auto it = m_sharedNumericEntries.begin(); it != m_sharedNumericEntries.end();) {
+    if (it->second.use_count() == 1) {
+      it = m_sharedNumericEntries.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void
+Fib::eraseNumericEntry(size_t index)
+{
+  if (index >= m_numericEntries.size() || m_numericEntries[index] == nullptr)
+    return;
+
+  m_numericEntries[index].reset();
+  --m_nNumericItems;
+}
+
+shared_ptr<fib::Entry>
+Fib::findNumericLongestPrefixMatch(const Name& name) const
+{
+  size_t index;
+  if (!this->getNumericIndex(name, false, index) ||
+      index >= m_numericEntries.size() || m_numericEntries[index] == nullptr) {
+    return shared_ptr<fib::Entry>();
+  }
+
+  if (m_nShadowingItems > 0) {
+    // a NameTree entry more specific than the numeric prefix takes precedence
+    shared_ptr<name_tree::Entry> nameTreeEntry =
+      m_nameTree.findLongestPrefixMatch(name, &predicate_NameTreeEntry_hasFibEntry);
+    if (static_cast<bool>(nameTreeEntry) &&
+        nameTreeEntry->getPrefix().size() > m_numericRoot.size() + 1) {
+      return nameTreeEntry->getFibEntry();
+    }
+  }
+
+  this->compactNumericEntries();
+  return m_numericEntries[index];
+}
+
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
+  shared_ptr<fib::Entry> numericEntry = this->findNumericLongestPrefixMatch(prefix);
+  if (static_cast<bool>(numericEntry)) {
+    return numericEntry;
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry =
     m_nameTree.findLongestPrefixMatch(prefix, &predicate_NameTreeEntry_hasFibEntry);
   if (static_cast<bool>(nameTreeEntry)) {
@@ -91,6 +291,11 @@ Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
+  shared_ptr<fib::Entry> numericEntry = this->findNumericLongestPrefixMatch(pitEntry.getName());
+  if (static_cast<bool>(numericEntry)) {
+    return numericEntry;
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(pitEntry);
 
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
@@ -101,6 +306,12 @@ Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 {
+  shared_ptr<fib::Entry> numericEntry =
+    this->findNumericLongestPrefixMatch(measurementsEntry.getName());
+  if (static_cast<bool>(numericEntry)) {
+    return numericEntry;
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(measurementsEntry);
 
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
@@ -111,6 +322,13 @@ Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 shared_ptr<fib::Entry>
 Fib::findExactMatch(const Name& prefix) const
 {
+  size_t index;
+  if (this->getNumericIndex(prefix, true, index)) {
+    if (index >= m_numericEntries.size() || m_numericEntries[index] == nullptr)
+      return shared_ptr<fib::Entry>();
+    return this->detachNumericEntry(index);
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.findExactMatch(prefix);
   if (static_cast<bool>(nameTreeEntry))
     return nameTreeEntry->getFibEntry();
@@ -120,6 +338,20 @@ Fib::findExactMatch(const Name& prefix) const
 std::pair<shared_ptr<fib::Entry>, bool>
 Fib::insert(const Name& prefix)
 {
+  size_t index;
+  if (this->getNumericIndex(prefix, true, index)) {
+    if (index >= m_numericEntries.size())
+      m_numericEntries.resize(index + 1);
+
+    if (static_cast<bool>(m_numericEntries[index]))
+      return std::make_pair(this->detachNumericEntry(index), false);
+
+    m_numericEntries[index] = make_shared<fib::Entry>(prefix);
+    m_dirtyNumericEntries.push_back(index);
+    ++m_nNumericItems;
+    return std::make_pair(m_numericEntries[index], true);
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(prefix);
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
@@ -127,6 +359,9 @@ Fib::insert(const Name& prefix)
   entry = make_shared<fib::Entry>(prefix);
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
+  m_nBytes += estimateEntrySize(prefix);
+  if (this->isShadowingNumeric(prefix))
+    ++m_nShadowingItems;
   return std::make_pair(entry, true);
 }
 
@@ -140,6 +375,11 @@ Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
     entry->removeAllNextHops();
   }
    end of removing nexthops*/
+  if (static_cast<bool>(nameTreeEntry->getFibEntry())) {
+    m_nBytes -= estimateEntrySize(nameTreeEntry->getPrefix());
+    if (this->isShadowingNumeric(nameTreeEntry->getPrefix()))
+      --m_nShadowingItems;
+  }
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   //m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   if(!m_nameTree.eraseEntryIfEmpty(nameTreeEntry))
@@ -158,6 +398,12 @@ Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
 void
 Fib::erase(const Name& prefix)
 {
+  size_t index;
+  if (this->getNumericIndex(prefix, true, index)) {
+    this->eraseNumericEntry(index);
+    return;
+  }
+
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.findExactMatch(prefix);
   if (static_cast<bool>(nameTreeEntry)) {
     this->erase(nameTreeEntry);
@@ -170,6 +416,14 @@ Fib::erase(const fib::Entry& entry)
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(entry);
   if (static_cast<bool>(nameTreeEntry)) {
     this->erase(nameTreeEntry);
+    return;
+  }
+
+  // numeric entry; shared entries (prefix is the root) do not identify a single prefix
+  size_t index;
+  if (this->getNumericIndex(entry.getPrefix(), true, index) &&
+      index < m_numericEntries.size() && m_numericEntries[index].get() == &entry) {
+    this->eraseNumericEntry(index);
   }
 }
 
@@ -192,6 +446,36 @@ Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
   for (fib::Entry* entry : toErase) {
     this->erase(*entry);
   }
+
+  if (m_hasNumericRoot) {
+    // nexthop lists of shared entries change, so shared entries are re-keyed
+    m_sharedNumericEntries.clear();
+    for (size_t index = 0; index < m_numericEntries.size(); ++index) {
+      shared_ptr<fib::Entry>& entry = m_numericEntries[index];
+      if (entry == nullptr)
+        continue;
+
+      entry->removeNextHop(face);
+      if (!entry->hasNextHops()) {
+        this->eraseNumericEntry(index);
+        continue;
+      }
+
+      if (!entry->isShared()) {
+        m_dirtyNumericEntries.push_back(index);
+      }
+      else {
+        NextHopKey key;
+        for (const fib::NextHop& nexthop : entry->getNextHops()) {
+          key.push_back(std::make_pair(nexthop.getFace().get(), nexthop.getCost()));
+        }
+        shared_ptr<fib::Entry>& sharedEntry = m_sharedNumericEntries[key];
+        if (sharedEntry == nullptr)
+          sharedEntry = entry;
+        entry = sharedEntry;
+      }
+    }
+  }
 }
 
 bool 
@@ -206,7 +490,55 @@ Fib::isEmpty(shared_ptr<fib::Entry> fibEntry) const
 Fib::const_iterator
 Fib::begin() const
 {
-  return const_iterator(m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry).begin());
+  return const_iterator(*this,
+                        m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry).begin(),
+                        0);
+}
+
+Fib::const_iterator::const_iterator(const Fib& fib, const NameTree::const_iterator& it,
+                                    size_t numericIndex)
+  : m_fib(&fib)
+  , m_nameTreeIterator(it)
+  , m_numericIndex(numericIndex)
+{
+  this->seekNumericEntry();
+}
+
+Fib::const_iterator&
+Fib::const_iterator::operator++()
+{
+  if (m_numericEntry != nullptr)
+    ++m_numericIndex;
+  else
+    ++m_nameTreeIterator;
+
+  this->seekNumericEntry();
+  return *this;
+}
+
+void
+Fib::const_iterator::seekNumericEntry()
+{
+  m_numericEntry.reset();
+  if (m_nameTreeIterator != m_fib->m_nameTree.end())
+    return;
+
+  const std::vector<shared_ptr<fib::Entry>>& entries = m_fib->m_numericEntries;
+  while (m_numericIndex < entries.size() && entries[m_numericIndex] == nullptr)
+    ++m_numericIndex;
+  if (m_numericIndex >= entries.size())
+    return;
+
+  m_numericEntry = entries[m_numericIndex];
+  if (m_numericEntry->isShared()) {
+    // enumerate a private copy, so the prefix is the one of this slot
+    shared_ptr<fib::Entry> copy =
+      make_shared<fib::Entry>(Name(m_fib->m_numericRoot).appendNumber(m_numericIndex));
+    for (const fib::NextHop& nexthop : m_numericEntry->getNextHops()) {
+      copy->addNextHop(nexthop.getFace(), nexthop.getCost());
+    }
+    m_numericEntry = copy;
+  }
 }
 
 NameTree&
@@ -52,6 +52,13 @@ public:
   size_t
   size() const;
 
+  /** \return approximate number of bytes taken by FIB entries (NameTree entries they are
+   *          attached to are accounted by the NameTree)
+   *  \sa memory_usage
+   */
+  size_t
+  getMemoryUsage() const;
+
 public: // lookup
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
@@ -72,6 +79,40 @@ public: // lookup
 
   NameTree& getNameTree() const;
 
+public: // direct-indexed numeric prefixes
+  /** \brief enables direct-indexed storage for numeric prefixes under \p root
+   *
+   *  FIB entries whose prefix is \p root followed by exactly one NonNegativeInteger
+   *  component (e.g., /prefix/42 created by Name::appendNumber) are kept in a dense array
+   *  indexed by that number instead of the NameTree.  Entries with identical nexthop lists
+   *  share one fib::Entry object.  Longest prefix match for names under such a prefix is
+   *  resolved with a single array access; all other names fall back to the NameTree.
+   *
+   *  Entries that already exist in the NameTree are moved into the array.
+   *
+   *  \note Entry returned by longest prefix match for a numeric prefix may be shared with
+   *        other numeric prefixes (fib::Entry::isShared) and its getPrefix() returns \p root;
+   *        insert() and findExactMatch() always return an entry private to the requested
+   *        prefix, so it can be modified.
+   *  \note Numeric entries are not attached to the NameTree (NameTree::get returns nullptr).
+   *        Measurements::get(const fib::Entry&) uses the prefix of a private entry and
+   *        returns nullptr for a shared entry, which does not identify a single prefix.
+   *        Strategies should keep per-prefix state with Measurements::get(const pit::Entry&).
+   */
+  void
+  setNumericRoot(const Name& root);
+
+  bool
+  hasNumericRoot() const;
+
+  const Name&
+  getNumericRoot() const;
+
+  /** \return number of distinct fib::Entry objects used by numeric prefixes
+   */
+  size_t
+  getNNumericEntryObjects() const;
+
 public: // mutation
   /** \brief inserts a FIB entry for prefix
    *  If an entry for exact same prefix exists, that entry is returned.
@@ -103,6 +144,9 @@ public: // enumeration
    *  \note Iteration order is implementation-specific and is undefined
    *  \note The returned iterator may get invalidated if FIB or another NameTree-based
    *        table is modified
+   *  \note Direct-indexed numeric entries are visited after the NameTree entries, each with
+   *        its own prefix.  Entries shared by several numeric prefixes are visited as copies,
+   *        so they must not be modified through the iterator.
    */
   const_iterator
   begin() const;
@@ -119,8 +163,7 @@ public: // enumeration
   public:
     const_iterator() = default;
 
-    explicit
-    const_iterator(const NameTree::const_iterator& it);
+    const_iterator(const Fib& fib, const NameTree::const_iterator& it, size_t numericIndex);
 
     ~const_iterator();
 
@@ -143,7 +186,17 @@ public: // enumeration
     operator!=(const const_iterator& other) const;
 
   private:
+    /** \brief when NameTree entries are exhausted, moves to the next used numeric slot
+     */
+    void
+    seekNumericEntry();
+
+  private:
+    const Fib* m_fib = nullptr;
     NameTree::const_iterator m_nameTreeIterator;
+    size_t m_numericIndex = 0;
+    /// entry of the current numeric slot (a copy if shared), nullptr for NameTree entries
+    shared_ptr<fib::Entry> m_numericEntry;
   };
 public:
   shared_ptr<fib::Entry>
@@ -156,9 +209,54 @@ private:
   void
   erase(shared_ptr<name_tree::Entry> nameTreeEntry);
 
+  /** \brief get index of numeric prefix
+   *  \param name name or prefix to check
+   *  \param isExact if true, \p name must be exactly root plus number
+   *  \retval true \p name is under a numeric prefix, \p index is set
+   */
+  bool
+  getNumericIndex(const Name& name, bool isExact, size_t& index) const;
+
+  /** \return whether \p prefix (to be stored in the NameTree) can shadow numeric entries
+   */
+  bool
+  isShadowingNumeric(const Name& prefix) const;
+
+  /** \brief make the entry in the slot private to that slot (copy-on-write)
+   */
+  shared_ptr<fib::Entry>&
+  detachNumericEntry(size_t index) const;
+
+  /** \brief replace private entries with shared entries with the same nexthop list
+   */
+  void
+  compactNumericEntries() const;
+
+  /** \return entry for the numeric prefix of \p name, or nullptr if the NameTree must be used
+   */
+  shared_ptr<fib::Entry>
+  findNumericLongestPrefixMatch(const Name& name) const;
+
+  void
+  eraseNumericEntry(size_t index);
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  /// approximate number of bytes taken by NameTree FIB entries
+  size_t m_nBytes;
+
+  /// key of shared numeric entries: ordered nexthop list
+  typedef std::vector<std::pair<const Face*, uint64_t>> NextHopKey;
+
+  bool m_hasNumericRoot;
+  Name m_numericRoot;
+  size_t m_nNumericItems;
+  /// number of NameTree FIB entries that are more specific than a numeric prefix
+  size_t m_nShadowingItems;
+  mutable std::vector<shared_ptr<fib::Entry>> m_numericEntries;
+  mutable std::vector<size_t> m_dirtyNumericEntries;
+  mutable std::map<NextHopKey, shared_ptr<fib::Entry>> m_sharedNumericEntries;
 
   /** \brief The empty FIB entry.
    *
@@ -172,19 +270,25 @@ private:
 inline size_t
 Fib::size() const
 {
-  return m_nItems;
+  return m_nItems + m_nNumericItems;
 }
 
-inline Fib::const_iterator
-Fib::end() const
+inline bool
+Fib::hasNumericRoot() const
 {
-  return const_iterator(m_nameTree.end());
+  return m_hasNumericRoot;
 }
 
-inline
-Fib::const_iterator::const_iterator(const NameTree::const_iterator& it)
-  : m_nameTreeIterator(it)
+inline const Name&
+Fib::getNumericRoot() const
 {
+  return m_numericRoot;
+}
+
+inline Fib::const_iterator
+Fib::end() const
+{
+  return const_iterator(*this, m_nameTree.end(), m_numericEntries.size());
 }
 
 inline
@@ -201,13 +305,6 @@ Fib::const_iterator::operator++(int)
   return temp;
 }
 
-inline Fib::const_iterator&
-Fib::const_iterator::operator++()
-{
-  ++m_nameTreeIterator;
-  return *this;
-}
-
 inline const fib::Entry&
 Fib::const_iterator::operator*() const
 {
@@ -217,19 +314,22 @@ Fib::const_iterator::operator*() const
 inline shared_ptr<fib::Entry>
 Fib::const_iterator::operator->() const
 {
+  if (m_numericEntry != nullptr)
+    return m_numericEntry;
   return m_nameTreeIterator->getFibEntry();
 }
 
 inline bool
 Fib::const_iterator::operator==(const Fib::const_iterator& other) const
 {
-  return m_nameTreeIterator == other.m_nameTreeIterator;
+  return m_nameTreeIterator == other.m_nameTreeIterator &&
+         m_numericIndex == other.m_numericIndex;
 }
 
 inline bool
 Fib::const_iterator::operator!=(const Fib::const_iterator& other) const
 {
-  return m_nameTreeIterator != other.m_nameTreeIterator;
+  return !(*this == other);
 }
 
 } // namespace nfd
@@ -51,6 +51,7 @@ public:
   get(const Name& name);
 
   /** \brief find or insert a Measurements entry for \p fibEntry->getPrefix()
+   *  \retval nullptr \p fibEntry is shared by several numeric prefixes (fib::Entry::isShared)
    */
   shared_ptr<measurements::Entry>
   get(const fib::Entry& fibEntry);
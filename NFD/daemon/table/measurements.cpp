@@ -27,6 +27,7 @@
 #include "name-tree.hpp"
 #include "pit-entry.hpp"
 #include "fib-entry.hpp"
+#include "memory-usage.hpp"
 
 namespace nfd {
 
@@ -35,9 +36,16 @@ using measurements::Entry;
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_nBytes(0)
 {
 }
 
+static inline size_t
+estimateEntrySize(const Name& prefix)
+{
+  return sizeof(Entry) + memory_usage::estimate(prefix);
+}
+
 shared_ptr<Entry>
 Measurements::get(name_tree::Entry& nte)
 {
@@ -48,6 +56,7 @@ Measurements::get(name_tree::Entry& nte)
   entry = make_shared<Entry>(nte.getPrefix());
   nte.setMeasurementsEntry(entry);
   ++m_nItems;
+  m_nBytes += estimateEntrySize(nte.getPrefix());
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
   entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
@@ -67,6 +76,13 @@ shared_ptr<Entry>
 Measurements::get(const fib::Entry& fibEntry)
 {
   shared_ptr<name_tree::Entry> nte = m_nameTree.get(fibEntry);
+  if (nte == nullptr) {
+    // direct-indexed numeric entry (Fib::setNumericRoot) is not attached to the NameTree;
+    // a shared entry stands for many prefixes, merging their measurements would be wrong
+    if (fibEntry.isShared())
+      return nullptr;
+    nte = m_nameTree.lookup(fibEntry.getPrefix());
+  }
   return this->get(*nte);
 }
 
@@ -160,6 +176,7 @@ Measurements::cleanup(Entry& entry)
     nte->setMeasurementsEntry(nullptr);
     m_nameTree.eraseEntryIfEmpty(nte);
     m_nItems--;
+    m_nBytes -= estimateEntrySize(nte->getPrefix());
   }
 }
 
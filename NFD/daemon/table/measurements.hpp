@@ -84,6 +84,7 @@ public:
   get(const Name& name);
 
   /** \brief find or insert a Measurements entry for \p fibEntry.getPrefix()
+   *  \retval nullptr \p fibEntry is shared by several numeric prefixes (fib::Entry::isShared)
    */
   shared_ptr<measurements::Entry>
   get(const fib::Entry& fibEntry);
@@ -131,6 +132,13 @@ public:
   size_t
   size() const;
 
+  /** \return approximate number of bytes taken by Measurements entries (strategy information
+   *          stored in them is not included)
+   *  \sa memory_usage
+   */
+  size_t
+  getMemoryUsage() const;
+
 private:
   void
   cleanup(measurements::Entry& entry);
@@ -147,6 +155,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  size_t m_nBytes;
 };
 
 inline time::nanoseconds
@@ -161,6 +170,12 @@ Measurements::size() const
   return m_nItems;
 }
 
+inline size_t
+Measurements::getMemoryUsage() const
+{
+  return m_nBytes;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_MEASUREMENTS_HPP
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+#define NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief approximate memory accounting of the tables
+ *
+ *  Tables keep a byte count that is updated on insert and erase (or derived from the
+ *  container size, when all entries have the same size), so it can be sampled at any time
+ *  without enumerating the table.  Estimates cover the table entries, the Names they keep,
+ *  and the nodes of the containers, but not the allocator overhead.  Name components are
+ *  counted as if every Name owned them, even when they share the wire buffer of a packet.
+ */
+namespace memory_usage {
+
+/** \brief approximate overhead of a node in a linked or hashed container
+ */
+const size_t NODE_OVERHEAD = 2 * sizeof(void*);
+
+/** \return approximate number of bytes taken by \p name
+ */
+inline size_t
+estimate(const Name& name)
+{
+  size_t nBytes = sizeof(Name) + name.size() * sizeof(name::Component);
+  for (const name::Component& component : name) {
+    nBytes += component.value_size();
+  }
+  return nBytes;
+}
+
+/** \return approximate number of bytes taken by \p interest
+ *  \note The estimate depends only on the Name, so it is the same when the Interest is inserted
+ *        and erased, even if its wire encoding has been created in between.
+ */
+inline size_t
+estimate(const Interest& interest)
+{
+  return sizeof(Interest) + estimate(interest.getName());
+}
+
+/** \return approximate number of bytes taken by \p data
+ */
+inline size_t
+estimate(const Data& data)
+{
+  return sizeof(Data) + estimate(data.getName()) + data.getContent().size();
+}
+
+} // namespace memory_usage
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_MEMORY_USAGE_HPP
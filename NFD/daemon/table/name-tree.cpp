@@ -24,6 +24,7 @@
  */
 
 #include "name-tree.hpp"
+#include "memory-usage.hpp"
 #include "core/logger.hpp"
 #include "core/city-hash.hpp"
 
@@ -113,9 +114,18 @@ computeHashSet(const Name& prefix)
 
 } // namespace name_tree
 
+// Name Tree Entry, its Node, and the pointer in the children list of the parent
+static inline size_t
+estimateEntrySize(const Name& prefix)
+{
+  return sizeof(name_tree::Entry) + sizeof(name_tree::Node) +
+         sizeof(shared_ptr<name_tree::Entry>) + memory_usage::estimate(prefix);
+}
+
 NameTree::NameTree(size_t nBuckets)
   : m_nItems(0)
   , m_nBuckets(nBuckets)
+  , m_nBytes(0)
   , m_minNBuckets(nBuckets)
   , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
   , m_enlargeFactor(2)       // double the hash table size
@@ -220,6 +230,7 @@ NameTree::lookup(const Name& prefix)
       if (ret.second == true)
         {
           m_nItems++; // Increase the counter
+          m_nBytes += estimateEntrySize(temp);
           entry->m_parent = parent;
 
           if (static_cast<bool>(parent))
@@ -382,6 +393,7 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
       BOOST_ASSERT(node->m_next == 0);
 
       m_nItems--;
+      m_nBytes -= estimateEntrySize(entry->getPrefix());
       delete node;
 
       if (static_cast<bool>(parent))
@@ -101,6 +101,14 @@ public: // information
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Get approximate number of bytes taken by the Name Tree
+   * \details Includes the Name Tree Entries with their prefixes and Nodes, and the bucket
+   * array, but not the FIB, PIT, and other table entries attached to them.
+   */
+  size_t
+  getMemoryUsage() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -305,6 +313,7 @@ private:
 private:
   size_t                        m_nItems;  // Number of items being stored
   size_t                        m_nBuckets; // Number of hash buckets
+  size_t                        m_nBytes;   // Approximate size of entries and nodes
   size_t                        m_minNBuckets; // Minimum number of hash buckets
   double                        m_enlargeLoadFactor;
   size_t                        m_enlargeThreshold;
@@ -344,6 +353,12 @@ NameTree::getNBuckets() const
   return m_nBuckets;
 }
 
+inline size_t
+NameTree::getMemoryUsage() const
+{
+  return m_nBytes + m_nBuckets * sizeof(name_tree::Node*);
+}
+
 inline shared_ptr<name_tree::Entry>
 NameTree::get(const fib::Entry& fibEntry) const
 {
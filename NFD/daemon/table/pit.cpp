@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "memory-usage.hpp"
 #include <type_traits>
 
 #include <boost/concept/assert.hpp>
@@ -54,6 +55,7 @@ BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Pit::const_iterator>));
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_nBytes(0)
 {
 }
 
@@ -61,6 +63,14 @@ Pit::~Pit()
 {
 }
 
+// PIT entry with one in-record and one out-record, and its Interest
+static inline size_t
+estimateEntrySize(const Interest& interest)
+{
+  return sizeof(pit::Entry) + sizeof(pit::InRecord) + sizeof(pit::OutRecord) +
+         2 * memory_usage::NODE_OVERHEAD + memory_usage::estimate(interest);
+}
+
 std::pair<shared_ptr<pit::Entry>, bool>
 Pit::insert(const Interest& interest)
 {
@@ -84,6 +94,7 @@ Pit::insert(const Interest& interest)
   shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
+  m_nBytes += estimateEntrySize(interest);
   return { entry, true };
 }
 
@@ -114,6 +125,7 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
 
   --m_nItems;
+  m_nBytes -= estimateEntrySize(pitEntry->getInterest());
 }
 
 Pit::const_iterator
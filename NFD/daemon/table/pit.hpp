@@ -58,6 +58,13 @@ public:
   size_t
   size() const;
 
+  /** \return approximate number of bytes taken by PIT entries and their Interests
+   *          (NameTree entries they are attached to are accounted by the NameTree)
+   *  \sa memory_usage
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
@@ -137,6 +144,7 @@ public: // enumeration
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  size_t m_nBytes;
 };
 
 inline size_t
@@ -145,6 +153,12 @@ Pit::size() const
   return m_nItems;
 }
 
+inline size_t
+Pit::getMemoryUsage() const
+{
+  return m_nBytes;
+}
+
 inline Pit::const_iterator
 Pit::end() const
 {
@@ -31,6 +31,9 @@
 
 #include "model/ndn-app-face.hpp"
 
+#include <algorithm>
+#include <vector>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerSit");
 
 namespace ns3 {
@@ -60,7 +63,49 @@ ConsumerSit::GetTypeId(void)
                     IntegerValue(std::numeric_limits<uint32_t>::max()),
                     MakeIntegerAccessor(&ConsumerSit::m_seqMax), MakeIntegerChecker<uint32_t>())
 
-    ;
+      .AddAttribute("InitialWindow", "Initial congestion window of a content (in chunks)",
+                    StringValue("1"), MakeDoubleAccessor(&ConsumerSit::m_initialWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("MaxWindow", "Maximum congestion window of a content (in chunks)",
+                    StringValue("64"), MakeDoubleAccessor(&ConsumerSit::m_maxWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("DestinationFlag", "Destination flag of Interests for chunks of a content",
+                    UintegerValue(0), MakeUintegerAccessor(&ConsumerSit::m_destinationFlag),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("FollowUpScope",
+                    "Flood scope of chunks requested after the first Data of the content "
+                    "arrived, -1 to use the scope of the request",
+                    IntegerValue(-1), MakeIntegerAccessor(&ConsumerSit::m_followUpScope),
+                    MakeIntegerChecker<int32_t>(-1))
+
+      .AddAttribute("FollowUpDestinationFlag",
+                    "Destination flag of chunks requested after the first Data of the content "
+                    "arrived, -1 to use DestinationFlag",
+                    IntegerValue(-1), MakeIntegerAccessor(&ConsumerSit::m_followUpDestinationFlag),
+                    MakeIntegerChecker<int32_t>(-1))
+
+      .AddAttribute("MaxRetransmissions",
+                    "Number of retransmissions of a chunk after which its content is given up",
+                    UintegerValue(10), MakeUintegerAccessor(&ConsumerSit::m_maxRetransmissions),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("FlowCompletion",
+                      "Time between the request of a content and the arrival of its last chunk",
+                      MakeTraceSourceAccessor(&ConsumerSit::m_flowCompletion),
+                      "ns3::ndn::ConsumerSit::FlowCompletionCallback")
+
+      .AddTraceSource("FlowAbort",
+                      "Time between the request of a content and giving it up, after a chunk "
+                      "timed out MaxRetransmissions times",
+                      MakeTraceSourceAccessor(&ConsumerSit::m_flowAbort),
+                      "ns3::ndn::ConsumerSit::FlowCompletionCallback")
+
+      .AddTraceSource("FlowWindow", "Congestion window of a content (in chunks)",
+                      MakeTraceSourceAccessor(&ConsumerSit::m_flowWindow),
+                      "ns3::ndn::ConsumerSit::FlowWindowCallback");
 
   return tid;
 }
@@ -68,6 +113,7 @@ ConsumerSit::GetTypeId(void)
 ConsumerSit::ConsumerSit()
   : m_frequency(1.0)
   , m_firstTime(true)
+  , m_nextFlowId(0)
 {
   NS_LOG_FUNCTION_NOARGS();
   m_seqMax = std::numeric_limits<uint32_t>::max();
@@ -77,6 +123,214 @@ ConsumerSit::~ConsumerSit()
 {
 }
 
+void
+ConsumerSit::StopApplication()
+{
+  m_flows.clear();
+  m_chunkFlows.clear();
+
+  Consumer::StopApplication();
+}
+
+void
+ConsumerSit::RequestContent(uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks,
+                            uint32_t scope)
+{
+  if (!m_active || nChunks == 0)
+    return;
+
+  NS_LOG_INFO("> Content " << prefixNumber << "/" << firstChunk << " (" << nChunks << " chunks)");
+
+  uint32_t flowId = m_nextFlowId++;
+  Flow& flow = m_flows[flowId];
+  flow.prefixNumber = prefixNumber;
+  flow.firstChunk = firstChunk;
+  flow.nextChunk = firstChunk;
+  flow.endChunk = firstChunk + nChunks;
+  flow.nReceived = 0;
+  flow.scope = scope;
+  flow.hasData = false;
+  flow.startTime = Simulator::Now();
+
+  flow.window = m_initialWindow;
+  flow.ssthresh = m_maxWindow;
+  flow.inFlight = 0;
+  flow.lastDecrease = Simulator::Now();
+
+  SendChunks(flowId);
+}
+
+size_t
+ConsumerSit::GetNActiveFlows() const
+{
+  return m_flows.size();
+}
+
+void
+ConsumerSit::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  Consumer::OnData(data);
+
+  const Name& name = data->getName();
+  if (m_chunkFlows.empty() || name.size() != m_interestName.size() + 2 || !name.at(-2).isNumber())
+    return;
+
+  uint64_t key = GetChunkKey(name.at(-2).toNumber(), name.at(-1).toSequenceNumber());
+
+  // the same chunk can be requested by several contents of the application
+  for (auto waiting = m_chunkFlows.find(key); waiting != m_chunkFlows.end();
+       waiting = m_chunkFlows.find(key)) {
+    std::map<uint32_t, Flow>::iterator i = m_flows.find(waiting->second);
+    m_chunkFlows.erase(waiting);
+    if (i == m_flows.end())
+      continue;
+
+    Flow& flow = i->second;
+    flow.inFlight--;
+    flow.nReceived++;
+    flow.hasData = true;
+
+    if (flow.window < flow.ssthresh)
+      flow.window += 1.0;
+    else
+      flow.window += 1.0 / flow.window;
+    flow.window = std::min(flow.window, m_maxWindow);
+    m_flowWindow(this, flow.prefixNumber, flow.firstChunk, flow.window);
+
+    if (flow.nReceived < flow.endChunk - flow.firstChunk) {
+      SendChunks(i->first);
+      continue;
+    }
+
+    NS_LOG_INFO("< Content " << flow.prefixNumber << "/" << flow.firstChunk << " in "
+                             << (Simulator::Now() - flow.startTime).GetSeconds() << "s");
+    m_flowCompletion(this, flow.prefixNumber, flow.firstChunk, flow.endChunk - flow.firstChunk,
+                     Simulator::Now() - flow.startTime);
+    m_flows.erase(i);
+  }
+}
+
+void
+ConsumerSit::OnTimeout(uint32_t prefixNumber, uint32_t sequenceNumber)
+{
+  Consumer::OnTimeout(prefixNumber, sequenceNumber);
+
+  if (prefixNumber == OutstandingRequestTable::NO_PREFIX)
+    return;
+
+  auto waiting = m_chunkFlows.equal_range(GetChunkKey(prefixNumber, sequenceNumber));
+  if (waiting.first == waiting.second)
+    return;
+
+  const OutstandingRequestTable::Entry* request = m_requests.Find(prefixNumber, sequenceNumber);
+  if (request != nullptr && request->retxCount > m_maxRetransmissions) {
+    std::vector<uint32_t> flowIds;
+    for (auto i = waiting.first; i != waiting.second; ++i)
+      flowIds.push_back(i->second);
+    for (uint32_t flowId : flowIds)
+      AbortFlow(flowId);
+    return;
+  }
+
+  Time sent = request != nullptr ? request->lastSent : Simulator::Now();
+
+  const Flow* retransmitFor = nullptr;
+  for (auto i = waiting.first; i != waiting.second; ++i) {
+    std::map<uint32_t, Flow>::iterator flow = m_flows.find(i->second);
+    if (flow == m_flows.end())
+      continue;
+
+    // decrease only once for chunks that were in flight at the previous decrease
+    if (sent >= flow->second.lastDecrease) {
+      flow->second.ssthresh = std::max(flow->second.window / 2.0, 1.0);
+      flow->second.window = flow->second.ssthresh;
+      flow->second.lastDecrease = Simulator::Now();
+      NS_LOG_DEBUG("Window of " << flow->second.prefixNumber << "/" << flow->second.firstChunk
+                                << ": " << flow->second.window);
+      m_flowWindow(this, flow->second.prefixNumber, flow->second.firstChunk,
+                   flow->second.window);
+    }
+    retransmitFor = &flow->second;
+  }
+
+  if (retransmitFor != nullptr)
+    SendChunk(*retransmitFor, sequenceNumber);
+}
+
+void
+ConsumerSit::SendChunks(uint32_t flowId)
+{
+  Flow& flow = m_flows[flowId];
+
+  while (flow.nextChunk < flow.endChunk && flow.inFlight < static_cast<uint32_t>(flow.window)) {
+    uint32_t chunk = flow.nextChunk++;
+    flow.inFlight++;
+    m_chunkFlows.insert(std::make_pair(GetChunkKey(flow.prefixNumber, chunk), flowId));
+
+    SendChunk(flow, chunk);
+  }
+}
+
+void
+ConsumerSit::SendChunk(const Flow& flow, uint32_t chunk)
+{
+  uint32_t scope = flow.scope;
+  uint32_t destinationFlag = m_destinationFlag;
+  if (flow.hasData) {
+    if (m_followUpScope >= 0)
+      scope = m_followUpScope;
+    if (m_followUpDestinationFlag >= 0)
+      destinationFlag = m_followUpDestinationFlag;
+  }
+
+  SendPacketWithFlags(flow.prefixNumber, chunk, scope, destinationFlag);
+}
+
+void
+ConsumerSit::AbortFlow(uint32_t flowId)
+{
+  std::map<uint32_t, Flow>::iterator i = m_flows.find(flowId);
+  if (i == m_flows.end())
+    return;
+
+  Flow& flow = i->second;
+  NS_LOG_INFO("x Content " << flow.prefixNumber << "/" << flow.firstChunk << " after "
+                           << (Simulator::Now() - flow.startTime).GetSeconds() << "s");
+
+  for (uint32_t chunk = flow.firstChunk; chunk < flow.nextChunk; chunk++) {
+    bool isWaiting = false;
+    bool isShared = false;
+    auto waiting = m_chunkFlows.equal_range(GetChunkKey(flow.prefixNumber, chunk));
+    for (auto j = waiting.first; j != waiting.second;) {
+      if (j->second == flowId) {
+        isWaiting = true;
+        j = m_chunkFlows.erase(j);
+      }
+      else {
+        isShared = true;
+        ++j;
+      }
+    }
+
+    // nobody else waits for the chunk, stop tracking its timeout
+    if (isWaiting && !isShared)
+      m_requests.Erase(flow.prefixNumber, chunk);
+  }
+
+  m_flowAbort(this, flow.prefixNumber, flow.firstChunk, flow.endChunk - flow.firstChunk,
+              Simulator::Now() - flow.startTime);
+  m_flows.erase(i);
+}
+
+uint64_t
+ConsumerSit::GetChunkKey(uint32_t prefixNumber, uint32_t chunk)
+{
+  return (static_cast<uint64_t>(prefixNumber) << 32) | chunk;
+}
+
 void
 ConsumerSit::ScheduleNextPacket()
 {
@@ -24,12 +24,30 @@
 
 #include "ndn-consumer.hpp"
 
+#include "ns3/traced-callback.h"
+
+#include <map>
+#include <unordered_map>
+
 namespace ns3 {
 namespace ndn {
 
 /**
  * @ingroup ndn-apps
  * @brief Ndn application for sending out Interest packets at a "constant" rate (Poisson process)
+ *
+ * Besides individual Interests (Consumer::SendPacketWithSeq), the application can fetch a
+ * whole content with RequestContent.  Chunks of the content are pipelined with a congestion
+ * window per content: the window grows by one chunk per Data in slow start and by one chunk
+ * per window afterwards, and it is halved when a chunk times out (at most once per window of
+ * chunks).  Timed-out chunks are retransmitted, timeouts follow the per-chunk RTT estimate.
+ * When a chunk times out after MaxRetransmissions retransmissions, the whole content is given
+ * up and reported through the FlowAbort trace source.
+ *
+ * The first chunk is sent with the flood scope of the request and DestinationFlag.  Chunks
+ * requested after the first Data of the content arrived use FollowUpScope and
+ * FollowUpDestinationFlag, if they are set.  Completion of every content is reported through
+ * the FlowCompletion trace source, changes of the window through FlowWindow.
  */
 class ConsumerSit : public Consumer {
 public:
@@ -43,7 +61,39 @@ public:
   ConsumerSit();
   virtual ~ConsumerSit();
 
+  /**
+   * @brief Fetch chunks [firstChunk, firstChunk + nChunks) of /<prefix>/<prefixNumber>
+   * @param scope flood scope of the Interests
+   */
+  void
+  RequestContent(uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks, uint32_t scope);
+
+  /**
+   * @brief Number of contents that are being fetched
+   */
+  size_t
+  GetNActiveFlows() const;
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+  using Consumer::OnTimeout;
+
+  virtual void
+  OnTimeout(uint32_t prefixNumber, uint32_t sequenceNumber);
+
+public:
+  typedef void (*FlowCompletionCallback)(Ptr<App> app, uint32_t prefixNumber, uint32_t firstChunk,
+                                         uint32_t nChunks, Time completionTime);
+
+  typedef void (*FlowWindowCallback)(Ptr<App> app, uint32_t prefixNumber, uint32_t firstChunk,
+                                     double window);
+
 protected:
+  virtual void
+  StopApplication();
+
   /**
    * \brief Constructs the Interest packet and sends it using a callback to the underlying NDN
    * protocol
@@ -70,6 +120,61 @@ protected:
   bool m_firstTime;
   Ptr<RandomVariableStream> m_random;
   std::string m_randomType;
+
+private:
+  /// @cond include_hidden
+  struct Flow {
+    uint32_t prefixNumber;
+    uint32_t firstChunk;
+    uint32_t nextChunk; ///< next chunk to request for the first time
+    uint32_t endChunk;
+    uint32_t nReceived;
+    uint32_t scope;
+    bool hasData; ///< first Data of the flow has been received
+    Time startTime;
+
+    double window;
+    double ssthresh;
+    uint32_t inFlight;
+    Time lastDecrease; ///< chunks sent before this time do not decrease the window again
+  };
+  /// @endcond
+
+  void
+  SendChunks(uint32_t flowId);
+
+  void
+  SendChunk(const Flow& flow, uint32_t chunk);
+
+  /**
+   * @brief Give up the flow, stop waiting for its chunks and report it through FlowAbort
+   */
+  void
+  AbortFlow(uint32_t flowId);
+
+  static uint64_t
+  GetChunkKey(uint32_t prefixNumber, uint32_t chunk);
+
+private:
+  double m_initialWindow;
+  double m_maxWindow;
+  uint32_t m_destinationFlag;
+  int32_t m_followUpScope;
+  int32_t m_followUpDestinationFlag;
+  uint32_t m_maxRetransmissions;
+
+  uint32_t m_nextFlowId;
+  std::map<uint32_t, Flow> m_flows;
+  std::unordered_multimap<uint64_t, uint32_t> m_chunkFlows; ///< flows waiting for the chunk
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* prefix number */, uint32_t /* first chunk */,
+                 uint32_t /* number of chunks */, Time /* completion time */> m_flowCompletion;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* prefix number */, uint32_t /* first chunk */,
+                 uint32_t /* number of chunks */, Time /* time until abort */> m_flowAbort;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* prefix number */, uint32_t /* first chunk */,
+                 double /* window */> m_flowWindow;
 };
 
 } // namespace ndn
@@ -50,9 +50,13 @@ public:
   virtual void
   OnData(shared_ptr<const Data> contentObject);
 
+  using Consumer::OnTimeout;
+
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  using Consumer::WillSendOutInterest;
+
   virtual void
   WillSendOutInterest(uint32_t sequenceNumber);
 
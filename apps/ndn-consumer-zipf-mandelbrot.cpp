@@ -24,8 +24,6 @@
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-fw-hop-count-tag.hpp"
 
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -90,17 +88,8 @@ ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  // attributes are set one by one, so the table is built only when the first content is drawn
+  m_sampler.reset();
 }
 
 uint32_t
@@ -178,29 +167,16 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
+  m_nameBuilder.SetPrefix(m_interestName);
 
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  interest->setName(m_nameBuilder.AppendSequenceNumber(seq).Build());
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
 
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_face->onReceiveInterest(*interest);
@@ -211,24 +187,14 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_sampler == nullptr) {
+    m_sampler = ZipfMandelbrotSampler::Get(m_N, m_q, m_s);
+  }
 
   double p_random = m_seqRng->GetValue();
-  while (p_random == 0) {
-    p_random = m_seqRng->GetValue();
-  }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_sampler->Sample(p_random); //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
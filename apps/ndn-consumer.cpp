@@ -91,6 +91,7 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_requests.SetTick(m_retxTimer);
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
@@ -114,17 +115,11 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+  // requests sent more than RTO ago, in the order they were sent
+  m_expired.clear();
+  m_requests.Expire(now - rto, m_expired);
+  for (const OutstandingRequestTable::Key& key : m_expired) {
+    OnTimeout(key.first, key.second);
   }
 
   m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
@@ -197,15 +192,12 @@ Consumer::SendPacket()
 	 //Onur End
   }
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
+  m_nameBuilder.SetPrefix(m_interestName);
 
   // shared_ptr<Interest> interest = make_shared<Interest> ();
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  interest->setName(m_nameBuilder.AppendSequenceNumber(seq).Build());
   time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
 
@@ -222,6 +214,13 @@ Consumer::SendPacket()
 
 void
 Consumer::SendPacketWithSeq(uint32_t prefixNumber, uint32_t seq, uint32_t scope)
+{
+  SendPacketWithFlags(prefixNumber, seq, scope, 0);
+}
+
+void
+Consumer::SendPacketWithFlags(uint32_t prefixNumber, uint32_t seq, uint32_t scope,
+                              uint32_t destinationFlag)
 {
   if (!m_active)
     return;
@@ -265,17 +264,15 @@ Consumer::SendPacketWithSeq(uint32_t prefixNumber, uint32_t seq, uint32_t scope)
   }
 */ 
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendNumber(prefixNumber);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
+  m_nameBuilder.SetPrefix(m_interestName);
 
   // shared_ptr<Interest> interest = make_shared<Interest> ();
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setFloodFlag(scope);
+  if (destinationFlag != 0)
+    interest->setDestinationFlag(destinationFlag);
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  interest->setName(m_nameBuilder.AppendNumber(prefixNumber).AppendSequenceNumber(seq).Build());
   time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
 
@@ -283,7 +280,7 @@ Consumer::SendPacketWithSeq(uint32_t prefixNumber, uint32_t seq, uint32_t scope)
   NS_LOG_INFO("> Interest for "<<prefixNumber<<"/"<<seq);
   //NS_LOG_INFO("> Interest for " << *nameWithSequence); //TODO remove
 
-  WillSendOutInterest(seq);
+  WillSendOutInterest(prefixNumber, seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_face->onReceiveInterest(*interest);
@@ -337,16 +334,13 @@ Consumer::FloodPacketWithSeq(uint32_t seq, uint32_t scope)
   }
 */ 
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
+  m_nameBuilder.SetPrefix(m_interestName);
 
   // shared_ptr<Interest> interest = make_shared<Interest> ();
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setFloodFlag(scope);
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  interest->setName(m_nameBuilder.AppendSequenceNumber(seq).Build());
   time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
 
@@ -383,9 +377,9 @@ Consumer::OnData(shared_ptr<const Data> data)
 
   // This could be a problem......
   uint32_t seq = data->getName().at(-1).toSequenceNumber();
-  if(data->getName().size() == 3)
-  {
-    uint32_t prefix = data->getName().at(-2).toNumber();
+  uint32_t prefix = OutstandingRequestTable::NO_PREFIX;
+  if (data->getName().size() == m_interestName.size() + 2 && data->getName().at(-2).isNumber()) {
+    prefix = data->getName().at(-2).toNumber(); // sent by SendPacketWithSeq
     NS_LOG_INFO("< DATA for " <<prefix<<"/"<<seq);
   }
   else
@@ -394,29 +388,20 @@ Consumer::OnData(shared_ptr<const Data> data)
   int hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      NS_LOG_INFO("Hop count: " << hopCount);
-    }
+    hopCount = ns3PacketTag->getHopCount();
+    NS_LOG_INFO("Hop count: " << hopCount);
   }
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
+  const OutstandingRequestTable::Entry* entry = m_requests.Find(prefix, seq);
+  if (entry != nullptr) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSent, entry->retxCount,
+                             hopCount);
+    m_requests.Erase(prefix, seq);
   }
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
-  }
-
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
+  if (prefix == OutstandingRequestTable::NO_PREFIX)
+    m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
 }
@@ -436,18 +421,33 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
 }
 
 void
-Consumer::WillSendOutInterest(uint32_t sequenceNumber)
+Consumer::OnTimeout(uint32_t prefixNumber, uint32_t sequenceNumber)
 {
-  NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+  if (prefixNumber == OutstandingRequestTable::NO_PREFIX) {
+    OnTimeout(sequenceNumber);
+    return;
+  }
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  NS_LOG_FUNCTION(prefixNumber << sequenceNumber);
 
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  m_rtt->IncreaseMultiplier(); // Double the next RTO
+  m_rtt->SentSeq(SequenceNumber32(sequenceNumber),
+                 1); // make sure to disable RTT calculation for this sample
+}
+
+void
+Consumer::WillSendOutInterest(uint32_t sequenceNumber)
+{
+  WillSendOutInterest(OutstandingRequestTable::NO_PREFIX, sequenceNumber);
+}
+
+void
+Consumer::WillSendOutInterest(uint32_t prefixNumber, uint32_t sequenceNumber)
+{
+  NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
+                                << m_requests.GetSize() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_requests.Send(prefixNumber, sequenceNumber, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
@@ -31,14 +31,11 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-outstanding-request-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-builder.hpp"
 
 #include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -70,6 +67,16 @@ public:
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  /**
+   * @brief Timeout event of a request for /<prefix>/<prefixNumber>/<seq>
+   *
+   * Requests sent with SendPacket and FloodPacketWithSeq (@p prefixNumber is
+   * OutstandingRequestTable::NO_PREFIX) are passed to OnTimeout(sequenceNumber).  Requests sent
+   * with SendPacketWithSeq are not retransmitted, only the RTO is backed off.
+   */
+  virtual void
+  OnTimeout(uint32_t prefixNumber, uint32_t sequenceNumber);
+
   /**
    * @brief Actually send packet
    */
@@ -81,6 +88,13 @@ public:
    */
   void
   SendPacketWithSeq(uint32_t prefixNumber, uint32_t seq, uint32_t scope);
+
+  /**
+   * @brief Send packet with a given sequence number, flood scope, and destination flag
+   */
+  void
+  SendPacketWithFlags(uint32_t prefixNumber, uint32_t seq, uint32_t scope,
+                      uint32_t destinationFlag);
   
   /**
    * @brief Broadcast packet with a given sequence number and scope
@@ -101,6 +115,13 @@ public:
   virtual void
   WillSendOutInterest(uint32_t sequenceNumber);
 
+  /**
+   * @brief An event that is fired just before an Interest for /<prefix>/<prefixNumber>/<seq> is
+   *        sent out (OutstandingRequestTable::NO_PREFIX if the name has no prefix number)
+   */
+  virtual void
+  WillSendOutInterest(uint32_t prefixNumber, uint32_t sequenceNumber);
+
 public:
   typedef void (*LastRetransmittedInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
   typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
@@ -154,6 +175,7 @@ protected:
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  NameBuilder m_nameBuilder; ///< \brief builds m_interestName followed by numbers
 
   /// @cond include_hidden
   /**
@@ -164,54 +186,8 @@ protected:
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  OutstandingRequestTable m_requests; ///< \brief send times and retx counts of requests
+  std::vector<OutstandingRequestTable::Key> m_expired; ///< \brief scratch space for timeouts
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-flow-dispatcher.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.FlowDispatcher");
+
+namespace ns3 {
+namespace ndn {
+
+FlowDispatcher::FlowDispatcher()
+  : m_chunkInterval(MilliSeconds(1))
+{
+}
+
+FlowDispatcher::~FlowDispatcher()
+{
+  Cancel();
+}
+
+void
+FlowDispatcher::SetConsumers(const ApplicationContainer& consumers)
+{
+  Cancel();
+
+  m_consumers.clear();
+  m_consumers.resize(consumers.GetN());
+  for (uint32_t i = 0; i < consumers.GetN(); i++) {
+    m_consumers[i].app = DynamicCast<Consumer>(consumers.Get(i));
+    NS_ASSERT_MSG(m_consumers[i].app != 0, "Application " << i << " is not an ndn::Consumer");
+    m_consumers[i].windowed = DynamicCast<ConsumerSit>(m_consumers[i].app);
+  }
+}
+
+uint32_t
+FlowDispatcher::GetNConsumers() const
+{
+  return m_consumers.size();
+}
+
+Ptr<Consumer>
+FlowDispatcher::GetConsumer(uint32_t consumer) const
+{
+  NS_ASSERT(consumer < m_consumers.size());
+  return m_consumers[consumer].app;
+}
+
+void
+FlowDispatcher::SetChunkInterval(Time interval)
+{
+  m_chunkInterval = interval;
+}
+
+void
+FlowDispatcher::StartFlow(uint32_t consumer, uint32_t producer, uint32_t firstChunk,
+                          uint32_t nChunks, uint32_t scope)
+{
+  NS_ASSERT(consumer < m_consumers.size());
+  if (nChunks == 0)
+    return;
+
+  ConsumerState& state = m_consumers[consumer];
+  if (m_chunkInterval.IsZero()) {
+    NS_ASSERT_MSG(state.windowed != 0, "Zero chunk interval requires ndn::ConsumerSit consumers");
+    state.windowed->RequestContent(producer, firstChunk, nChunks, scope);
+    return;
+  }
+
+  state.app->SendPacketWithSeq(producer, firstChunk, scope);
+
+  if (nChunks > 1) {
+    Flow flow = {Simulator::Now() + m_chunkInterval, producer, firstChunk + 1,
+                 firstChunk + nChunks, scope};
+    state.flows.push(flow);
+    ScheduleChunks(consumer);
+  }
+}
+
+void
+FlowDispatcher::Cancel()
+{
+  for (ConsumerState& state : m_consumers) {
+    Simulator::Cancel(state.sendEvent);
+    state.flows = std::priority_queue<Flow, std::vector<Flow>, FlowLater>();
+  }
+}
+
+void
+FlowDispatcher::Clear()
+{
+  Cancel();
+  m_consumers.clear();
+}
+
+void
+FlowDispatcher::SendChunks(uint32_t consumer)
+{
+  ConsumerState& state = m_consumers[consumer];
+  Time now = Simulator::Now();
+
+  while (!state.flows.empty() && state.flows.top().nextSend <= now) {
+    Flow flow = state.flows.top();
+    state.flows.pop();
+
+    state.app->SendPacketWithSeq(flow.producer, flow.nextChunk, flow.scope);
+
+    flow.nextChunk++;
+    flow.nextSend += m_chunkInterval;
+    if (flow.nextChunk < flow.endChunk) {
+      state.flows.push(flow);
+    }
+  }
+
+  ScheduleChunks(consumer);
+}
+
+void
+FlowDispatcher::ScheduleChunks(uint32_t consumer)
+{
+  ConsumerState& state = m_consumers[consumer];
+  if (state.flows.empty())
+    return;
+
+  Time next = state.flows.top().nextSend;
+  if (state.sendEvent.IsRunning()) {
+    if (Simulator::Now() + Simulator::GetDelayLeft(state.sendEvent) <= next)
+      return;
+    Simulator::Cancel(state.sendEvent);
+  }
+
+  state.sendEvent =
+    Simulator::Schedule(next - Simulator::Now(), &FlowDispatcher::SendChunks, this, consumer);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FLOW_DISPATCHER_H
+#define NDN_FLOW_DISPATCHER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+#include "ndn-consumer-sit.hpp"
+
+#include "ns3/application-container.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <queue>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Dispatcher of chunk requests of flows to consumer applications
+ *
+ * A flow requests a range of consecutive chunks from a producer, one chunk every chunk
+ * interval, through Consumer::SendPacketWithSeq.  Flows of a consumer are kept in a heap
+ * ordered by the time of their next chunk, and a single event per consumer serves all of them,
+ * so the number of pending events does not depend on the number of active flows.
+ *
+ * If the chunk interval is zero, flows are handed over to ConsumerSit::RequestContent and
+ * chunks are paced by the congestion window of the consumer.
+ *
+ * Used by request generators (WorkloadGenerator, TraceReplay).
+ */
+class FlowDispatcher {
+public:
+  FlowDispatcher();
+
+  ~FlowDispatcher();
+
+  /**
+   * @brief Set consumer applications, all of them must be ndn::Consumer (ndn::ConsumerSit if the
+   *        chunk interval is zero)
+   */
+  void
+  SetConsumers(const ApplicationContainer& consumers);
+
+  uint32_t
+  GetNConsumers() const;
+
+  Ptr<Consumer>
+  GetConsumer(uint32_t consumer) const;
+
+  void
+  SetChunkInterval(Time interval);
+
+  /**
+   * @brief Send the first chunk of the flow now and schedule the remaining chunks (or start
+   *        windowed retrieval of all chunks if the chunk interval is zero)
+   * @param consumer index of the consumer application
+   * @param producer producer number (see Consumer::SendPacketWithSeq)
+   * @param firstChunk sequence number of the first chunk
+   * @param nChunks number of chunks
+   * @param scope flood scope of the Interests
+   */
+  void
+  StartFlow(uint32_t consumer, uint32_t producer, uint32_t firstChunk, uint32_t nChunks,
+            uint32_t scope);
+
+  /**
+   * @brief Cancel all pending chunk requests
+   */
+  void
+  Cancel();
+
+  /**
+   * @brief Release consumer applications
+   */
+  void
+  Clear();
+
+private:
+  void
+  SendChunks(uint32_t consumer);
+
+  void
+  ScheduleChunks(uint32_t consumer);
+
+private:
+  /// @cond include_hidden
+  struct Flow {
+    Time nextSend;
+    uint32_t producer;
+    uint32_t nextChunk;
+    uint32_t endChunk;
+    uint32_t scope;
+  };
+
+  struct FlowLater {
+    bool
+    operator()(const Flow& a, const Flow& b) const
+    {
+      return a.nextSend > b.nextSend;
+    }
+  };
+
+  struct ConsumerState {
+    Ptr<Consumer> app;
+    Ptr<ConsumerSit> windowed; ///< same application if it supports windowed retrieval
+    std::priority_queue<Flow, std::vector<Flow>, FlowLater> flows;
+    EventId sendEvent;
+  };
+  /// @endcond
+
+  std::vector<ConsumerState> m_consumers;
+  Time m_chunkInterval;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FLOW_DISPATCHER_H
@@ -81,6 +81,8 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  BuildDataTemplate();
+
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -93,21 +95,9 @@ Producer::StopApplication()
 }
 
 void
-Producer::OnInterest(shared_ptr<const Interest> interest)
+Producer::BuildDataTemplate()
 {
-  App::OnInterest(interest); // tracing inside
-
-  NS_LOG_FUNCTION(this << interest);
-
-  if (!m_active)
-    return;
-
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
   auto data = make_shared<Data>();
-  data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
   data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
@@ -124,9 +114,31 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
 
   data->setSignature(signature);
 
+  // encoded once, copies of the template share encoded MetaInfo, Content, and Signature
+  data->getMetaInfo().wireEncode();
+  data->wireEncode();
+  m_dataTemplate = data;
+}
+
+void
+Producer::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  // only the name differs from the template
+  auto data = make_shared<Data>(*m_dataTemplate);
+  data->setName(interest->getName());
+  // dataName.append(m_postfix);
+  // dataName.appendVersion();
+
   //NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-  // to create real wire encoding
+  // to create real wire encoding, the only per-Data copy of the payload
   data->wireEncode();
   if(data->getName().size() == 3)
     NFD_LOG_INFO("> Data for " << data->getName().at(-2).toNumber()<<"/"<<data->getName().at(-1).toSequenceNumber());
@@ -39,6 +39,19 @@ namespace ndn {
  * which replying every incoming Interest with Data packet with a specified
  * size and name same as in Interest.cation, which replying every incoming Interest
  * with Data packet with a specified size and name same as in Interest.
+ *
+ * MetaInfo, Content, and the fake signature are identical for all Data packets of the
+ * producer, so they are encoded once when the application starts.  Every Data packet is a copy
+ * of this template that shares the encoded elements and has the name of the Interest, no
+ * payload buffer is allocated per Data.
+ *
+ * The wire encoding of each packet is still a separate contiguous buffer that holds a copy of
+ * the payload: a Block cannot refer to several buffers, and the Content Store (full name),
+ * tracers (packet size), and ns-3 packets need the complete wire.  Splicing the name into a
+ * shared template wire without copying the payload is not implemented.
+ *
+ * PayloadSize, Freshness, Signature, and KeyLocator are read when the application starts,
+ * later changes of these attributes take effect after the application is restarted.
  */
 class Producer : public App {
 public:
@@ -59,6 +72,13 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Encode the parts of Data packets that do not depend on the Interest
+   */
+  void
+  BuildDataTemplate();
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +87,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  shared_ptr<const Data> m_dataTemplate; ///< Data with encoded MetaInfo, Content, and Signature
 };
 
 } // namespace ndn
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-replay.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/node.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceReplay");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(TraceReplay);
+
+TypeId
+TraceReplay::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::TraceReplay")
+      .SetGroupName("Ndn")
+      .SetParent<Application>()
+      .AddConstructor<TraceReplay>()
+
+      .AddAttribute("TraceFile", "Name of the binary request trace file", StringValue(""),
+                    MakeStringAccessor(&TraceReplay::m_traceFile), MakeStringChecker())
+
+      .AddAttribute("ChunkInterval",
+                    "Interval between chunk requests of a flow, 0 to let ConsumerSit pace the "
+                    "chunks with its congestion window",
+                    StringValue("8.192ms"), MakeTimeAccessor(&TraceReplay::m_chunkInterval),
+                    MakeTimeChecker());
+
+  return tid;
+}
+
+TraceReplay::TraceReplay()
+  : m_nextRecord(0)
+  , m_nSkipped(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+TraceReplay::~TraceReplay()
+{
+}
+
+void
+TraceReplay::SetConsumers(const ApplicationContainer& consumers)
+{
+  m_dispatcher.SetConsumers(consumers);
+
+  m_nodeToConsumer.clear();
+  for (uint32_t i = 0; i < consumers.GetN(); i++) {
+    uint32_t nodeId = consumers.Get(i)->GetNode()->GetId();
+    if (nodeId >= m_nodeToConsumer.size())
+      m_nodeToConsumer.resize(nodeId + 1, -1);
+
+    NS_ASSERT_MSG(m_nodeToConsumer[nodeId] < 0, "Node " << nodeId << " has several consumers");
+    m_nodeToConsumer[nodeId] = i;
+  }
+}
+
+uint64_t
+TraceReplay::GetNReplayed() const
+{
+  return m_nextRecord;
+}
+
+void
+TraceReplay::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  if (!m_trace.Open(m_traceFile)) {
+    NS_FATAL_ERROR("Cannot open request trace " << m_traceFile);
+  }
+  NS_LOG_INFO("Replaying " << m_trace.GetNRecords() << " requests from " << m_traceFile);
+
+  m_dispatcher.SetChunkInterval(m_chunkInterval);
+  m_nextRecord = 0;
+  m_nSkipped = 0;
+  ScheduleNextRecord();
+}
+
+void
+TraceReplay::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Simulator::Cancel(m_replayEvent);
+  m_dispatcher.Cancel();
+  m_trace.Close();
+}
+
+void
+TraceReplay::DoDispose()
+{
+  m_dispatcher.Clear();
+  m_trace.Close();
+
+  Application::DoDispose();
+}
+
+void
+TraceReplay::ReplayRecords()
+{
+  // all records with the same timestamp are replayed by one event
+  int64_t now = Simulator::Now().GetNanoSeconds();
+  while (m_nextRecord < m_trace.GetNRecords()) {
+    const RequestTrace::Record& record = m_trace.GetRecord(m_nextRecord);
+    if (record.time > now)
+      break;
+    m_nextRecord++;
+
+    if (record.consumerNode >= m_nodeToConsumer.size()
+        || m_nodeToConsumer[record.consumerNode] < 0) {
+      NS_LOG_DEBUG("No consumer on node " << record.consumerNode << ", request skipped");
+      m_nSkipped++;
+      continue;
+    }
+
+    m_dispatcher.StartFlow(m_nodeToConsumer[record.consumerNode], record.producer,
+                           record.content, record.nChunks, record.scope);
+  }
+
+  ScheduleNextRecord();
+}
+
+void
+TraceReplay::ScheduleNextRecord()
+{
+  if (m_nextRecord >= m_trace.GetNRecords()) {
+    NS_LOG_INFO("Trace replay complete: " << m_nextRecord << " requests, " << m_nSkipped
+                                          << " skipped");
+    return;
+  }
+
+  // records in the past (before the application started) are replayed immediately
+  Time delay = NanoSeconds(m_trace.GetRecord(m_nextRecord).time) - Simulator::Now();
+  if (delay.IsNegative())
+    delay = Time();
+
+  m_replayEvent = Simulator::Schedule(delay, &TraceReplay::ReplayRecords, this);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_REPLAY_H
+#define NDN_TRACE_REPLAY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-flow-dispatcher.hpp"
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include "ns3/application.h"
+#include "ns3/application-container.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Replay of a binary request trace (see RequestTrace)
+ *
+ * Every record starts a flow on the consumer application installed on the record's consumer
+ * node: NumChunks chunks starting from the content's sequence number are requested from the
+ * producer, one every ChunkInterval, through Consumer::SendPacketWithSeq (or through
+ * ConsumerSit::RequestContent if ChunkInterval is zero).
+ *
+ * The trace is streamed from a memory mapping in time order; only one record is looked ahead,
+ * so memory use and the number of pending events do not depend on the trace length.
+ */
+class TraceReplay : public Application {
+public:
+  static TypeId
+  GetTypeId();
+
+  TraceReplay();
+  virtual ~TraceReplay();
+
+  /**
+   * @brief Set consumer applications, at most one per node
+   */
+  void
+  SetConsumers(const ApplicationContainer& consumers);
+
+  /**
+   * @brief Get number of records that have been replayed so far
+   */
+  uint64_t
+  GetNReplayed() const;
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  virtual void
+  DoDispose();
+
+private:
+  void
+  ReplayRecords();
+
+  void
+  ScheduleNextRecord();
+
+private:
+  std::string m_traceFile;
+  Time m_chunkInterval;
+
+  RequestTrace m_trace;
+  uint64_t m_nextRecord;
+  uint64_t m_nSkipped;
+  EventId m_replayEvent;
+
+  FlowDispatcher m_dispatcher;
+  std::vector<int32_t> m_nodeToConsumer; ///< node ID -> consumer index, or -1
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_REPLAY_H
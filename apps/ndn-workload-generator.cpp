@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-workload-generator.hpp"
+
+#include "helper/ndn-global-routing-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.WorkloadGenerator");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(WorkloadGenerator);
+
+TypeId
+WorkloadGenerator::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::WorkloadGenerator")
+      .SetGroupName("Ndn")
+      .SetParent<Application>()
+      .AddConstructor<WorkloadGenerator>()
+
+      .AddAttribute("NumberOfContents", "Number of the contents in total", StringValue("100"),
+                    MakeUintegerAccessor(&WorkloadGenerator::m_nContents),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("q", "Zipf-Mandelbrot parameter of improve rank", StringValue("0"),
+                    MakeDoubleAccessor(&WorkloadGenerator::m_q), MakeDoubleChecker<double>())
+
+      .AddAttribute("s", "Zipf-Mandelbrot parameter of power", StringValue("0.7"),
+                    MakeDoubleAccessor(&WorkloadGenerator::m_s), MakeDoubleChecker<double>())
+
+      .AddAttribute("ArrivalRate", "Rate of flow arrivals (flows per second)", StringValue("1.0"),
+                    MakeDoubleAccessor(&WorkloadGenerator::m_arrivalRate),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("NumChunks", "Number of chunks each flow requests", StringValue("1"),
+                    MakeUintegerAccessor(&WorkloadGenerator::m_nChunks),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("ChunkInterval",
+                    "Interval between chunk requests of a flow, 0 to let ConsumerSit pace the "
+                    "chunks with its congestion window",
+                    StringValue("8.192ms"), MakeTimeAccessor(&WorkloadGenerator::m_chunkInterval),
+                    MakeTimeChecker())
+
+      .AddAttribute("ScopeIncrement",
+                    "Value added to the path cost to the producer to get the flood scope",
+                    StringValue("0"), MakeUintegerAccessor(&WorkloadGenerator::m_scopeIncrement),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("InitFraction",
+                    "Initialization period lasts until this fraction of contents is requested",
+                    StringValue("0.3"), MakeDoubleAccessor(&WorkloadGenerator::m_initFraction),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("InitGap", "Silence between initialization and observation periods",
+                    StringValue("10s"), MakeTimeAccessor(&WorkloadGenerator::m_initGap),
+                    MakeTimeChecker())
+
+      .AddAttribute("ObservationLength", "Length of the observation period", StringValue("100s"),
+                    MakeTimeAccessor(&WorkloadGenerator::m_observationLength), MakeTimeChecker())
+
+      .AddAttribute("DrainTime",
+                    "If not zero, simulation is stopped this long after the observation period",
+                    StringValue("0s"), MakeTimeAccessor(&WorkloadGenerator::m_drainTime),
+                    MakeTimeChecker());
+
+  return tid;
+}
+
+WorkloadGenerator::WorkloadGenerator()
+  : m_interArrival(CreateObject<ExponentialRandomVariable>())
+  , m_consumerRng(CreateObject<UniformRandomVariable>())
+  , m_isInitPeriod(true)
+  , m_nRequested(0)
+  , m_nFlows(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+WorkloadGenerator::~WorkloadGenerator()
+{
+}
+
+void
+WorkloadGenerator::SetConsumers(const ApplicationContainer& consumers)
+{
+  m_dispatcher.SetConsumers(consumers);
+}
+
+void
+WorkloadGenerator::SetProducerNodes(const NodeContainer& producers)
+{
+  m_producers = producers;
+}
+
+Time
+WorkloadGenerator::GetInitPeriodEnd() const
+{
+  return m_initPeriodEnd;
+}
+
+int64_t
+WorkloadGenerator::AssignStreams(int64_t stream)
+{
+  m_interArrival->SetStream(stream);
+  m_consumerRng->SetStream(stream + 1);
+  return 2;
+}
+
+void
+WorkloadGenerator::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  NS_ASSERT_MSG(m_dispatcher.GetNConsumers() > 0 && m_producers.GetN() > 0,
+                "Consumers and producers must be set before the generator starts");
+
+  // CreateObject applies the attribute defaults after the constructor, parameters have to be set
+  // as attributes
+  m_contents = CreateObject<ConsumerZipfMandelbrot>();
+  m_contents->SetAttribute("NumberOfContents", UintegerValue(m_nContents));
+  m_contents->SetAttribute("q", DoubleValue(m_q));
+  m_contents->SetAttribute("s", DoubleValue(m_s));
+  m_dispatcher.SetChunkInterval(m_chunkInterval);
+  m_interArrival->SetAttribute("Mean", DoubleValue(1.0 / m_arrivalRate));
+
+  m_isInitPeriod = true;
+  m_initPeriodEnd = Time();
+  m_isRequested.assign(m_nContents + 1, false);
+  m_nRequested = 0;
+  m_nFlows = 0;
+
+  m_arrivalEvent = Simulator::ScheduleNow(&WorkloadGenerator::OnArrival, this);
+}
+
+void
+WorkloadGenerator::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Simulator::Cancel(m_arrivalEvent);
+  m_dispatcher.Cancel();
+}
+
+void
+WorkloadGenerator::DoDispose()
+{
+  m_dispatcher.Clear();
+  m_producers = NodeContainer();
+  m_contents = 0;
+
+  Application::DoDispose();
+}
+
+void
+WorkloadGenerator::OnArrival()
+{
+  uint32_t content = m_contents->GetNextSeq();
+  NS_ASSERT(content >= 1 && content <= m_nContents);
+  uint32_t producer = content % m_producers.GetN();
+  uint32_t consumer = m_consumerRng->GetInteger(0, m_dispatcher.GetNConsumers() - 1);
+
+  uint32_t cost = GlobalRoutingHelper::GetPathCost(m_dispatcher.GetConsumer(consumer)->GetNode(),
+                                                   m_producers.Get(producer));
+  if (cost == GlobalRoutingHelper::UNREACHABLE) {
+    cost = 0;
+  }
+
+  m_dispatcher.StartFlow(consumer, producer, content, m_nChunks, cost + m_scopeIncrement);
+
+  m_nFlows++;
+  if (!m_isRequested[content]) {
+    m_isRequested[content] = true;
+    m_nRequested++;
+  }
+
+  ScheduleNextArrival();
+}
+
+void
+WorkloadGenerator::ScheduleNextArrival()
+{
+  Time next = Seconds(m_interArrival->GetValue());
+
+  if (m_isInitPeriod) {
+    if (m_nRequested < m_initFraction * m_nContents) {
+      m_arrivalEvent = Simulator::Schedule(next, &WorkloadGenerator::OnArrival, this);
+      return;
+    }
+
+    NS_LOG_INFO("Initialization complete " << m_nFlows * m_nChunks);
+    m_isInitPeriod = false;
+    m_isRequested.assign(m_nContents + 1, false);
+    m_nRequested = 0;
+    m_nFlows = 0;
+
+    next += m_initGap;
+    m_initPeriodEnd = Simulator::Now() + next;
+    m_arrivalEvent = Simulator::Schedule(next, &WorkloadGenerator::OnArrival, this);
+    return;
+  }
+
+  Time observationEnd = m_initPeriodEnd + m_observationLength;
+  if (Simulator::Now() + next < observationEnd) {
+    m_arrivalEvent = Simulator::Schedule(next, &WorkloadGenerator::OnArrival, this);
+    return;
+  }
+
+  NS_LOG_INFO("Observation complete: Number of Unique content during observation: "
+              << m_nRequested);
+  NS_LOG_INFO("Observation complete: Number of requests during observation: " << m_nFlows);
+  if (!m_drainTime.IsZero()) {
+    Simulator::Stop(observationEnd + m_drainTime - Simulator::Now());
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
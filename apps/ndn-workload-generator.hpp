@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_WORKLOAD_GENERATOR_H
+#define NDN_WORKLOAD_GENERATOR_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer-zipf-mandelbrot.hpp"
+#include "ndn-flow-dispatcher.hpp"
+
+#include "ns3/application.h"
+#include "ns3/application-container.h"
+#include "ns3/node-container.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Generator of content requests that are dispatched to a set of consumer applications
+ *
+ * Flows arrive as a Poisson process (ArrivalRate).  For every flow, the content is drawn from
+ * a Zipf-Mandelbrot distribution, the producer is content % number of producers, and the
+ * consumer is selected uniformly.  The flow requests NumChunks consecutive chunks starting at
+ * the content index, one chunk every ChunkInterval, with the flood scope set to the path cost
+ * from the consumer to the producer (GlobalRoutingHelper::GetPathCost) plus ScopeIncrement.
+ * With zero ChunkInterval, chunks are fetched by ConsumerSit::RequestContent instead.
+ *
+ * The workload consists of an initialization period, which lasts until InitFraction of all
+ * contents has been requested at least once, followed by InitGap of silence and
+ * ObservationLength of observation.
+ *
+ * The next arrival is drawn only when the previous one fires, and chunks are sent by
+ * FlowDispatcher, so the number of pending events is bounded by the number of consumers plus
+ * one regardless of the simulation length.
+ *
+ * The generator is not bound to any particular node and can be installed on any of them.
+ */
+class WorkloadGenerator : public Application {
+public:
+  static TypeId
+  GetTypeId();
+
+  WorkloadGenerator();
+  virtual ~WorkloadGenerator();
+
+  /**
+   * @brief Set consumer applications, flows are dispatched to Consumer::SendPacketWithSeq
+   */
+  void
+  SetConsumers(const ApplicationContainer& consumers);
+
+  /**
+   * @brief Set nodes of producers, producer i serves /<prefix>/i
+   */
+  void
+  SetProducerNodes(const NodeContainer& producers);
+
+  /**
+   * @brief Get the end of the initialization period (zero if it did not end yet)
+   */
+  Time
+  GetInitPeriodEnd() const;
+
+  /**
+   * @brief Assign a fixed random variable stream number to the random variables used by the
+   *        generator
+   * @return number of streams that have been assigned
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  virtual void
+  DoDispose();
+
+private:
+  void
+  OnArrival();
+
+  void
+  ScheduleNextArrival();
+
+private:
+  FlowDispatcher m_dispatcher;
+  NodeContainer m_producers;
+
+  uint32_t m_nContents;
+  double m_q;
+  double m_s;
+  double m_arrivalRate;
+  uint32_t m_nChunks;
+  Time m_chunkInterval;
+  uint32_t m_scopeIncrement;
+  double m_initFraction;
+  Time m_initGap;
+  Time m_observationLength;
+  Time m_drainTime;
+
+  Ptr<ConsumerZipfMandelbrot> m_contents;
+  Ptr<ExponentialRandomVariable> m_interArrival;
+  Ptr<UniformRandomVariable> m_consumerRng;
+
+  bool m_isInitPeriod;
+  Time m_initPeriodEnd;
+  std::vector<bool> m_isRequested; ///< content was requested in the current period
+  uint32_t m_nRequested;           ///< number of distinct contents requested in the current period
+  uint32_t m_nFlows;               ///< number of flows in the current period
+  EventId m_arrivalEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_WORKLOAD_GENERATOR_H
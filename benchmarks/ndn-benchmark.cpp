@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/map-scheduler.h"
+
+#include "ns3/ndnSIM/apps/ndn-workload-generator.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * Simulation throughput benchmark
+ *
+ * Runs one of the canonical scenarios with fixed RNG seed and run number for a bounded
+ * simulated time and reports, as one JSON object per line:
+ *
+ * - wallTime: wall-clock seconds spent in Simulator::Run
+ * - events: number of events removed from the scheduler
+ * - eventsPerSecond: events per wall-clock second
+ * - interestsForwarded: sum of outgoing Interest counters of all forwarders
+ * - interestsPerSecond: forwarded Interests per wall-clock second
+ * - peakRss: peak resident set size of the process (bytes)
+ *
+ * Scenarios:
+ *
+ * - tree: ndn-tree-tracers topology (4 consumers, 100 Interests per second each)
+ * - grid: ndn-grid 3x3 topology (1 consumer, 100 Interests per second)
+ * - sit: ndn-sit-test style run on a Rocketfuel map, consumer and producer on every node,
+ *        pick-one strategy, requests drawn by WorkloadGenerator, SIT capacity SitSize
+ * - nosit: same as sit with SIT disabled (capacity 0)
+ *
+ * Each run measures a single scenario, so that the peak RSS is not affected by the previous
+ * ones.  benchmarks/run-benchmarks.py runs all of them and compares the results against the
+ * stored baselines:
+ *
+ *     ./waf --run "ndn-benchmark --scenario=tree --output=bench.json"
+ */
+
+/// @cond include_hidden
+
+/**
+ * Map scheduler that counts events removed from the queue (executed or cancelled)
+ */
+class CountingMapScheduler : public MapScheduler {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CountingMapScheduler")
+                          .SetParent<MapScheduler>()
+                          .AddConstructor<CountingMapScheduler>();
+    return tid;
+  }
+
+  virtual Event
+  RemoveNext()
+  {
+    s_nEvents++;
+    return MapScheduler::RemoveNext();
+  }
+
+  static uint64_t s_nEvents;
+};
+
+uint64_t CountingMapScheduler::s_nEvents = 0;
+
+NS_OBJECT_ENSURE_REGISTERED(CountingMapScheduler);
+
+/// @endcond
+
+static void
+SetupTree()
+{
+  AnnotatedTopologyReader topologyReader("", 1);
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-tree.txt");
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> consumers[4] = {Names::Find<Node>("leaf-1"), Names::Find<Node>("leaf-2"),
+                            Names::Find<Node>("leaf-3"), Names::Find<Node>("leaf-4")};
+  Ptr<Node> producer = Names::Find<Node>("root");
+
+  for (int i = 0; i < 4; i++) {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetAttribute("Frequency", StringValue("100"));
+    consumerHelper.SetPrefix("/root/" + Names::FindName(consumers[i]));
+    consumerHelper.Install(consumers[i]);
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  ndnGlobalRoutingHelper.AddOrigins("/root", producer);
+  producerHelper.SetPrefix("/root");
+  producerHelper.Install(producer);
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+}
+
+static void
+SetupGrid()
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> producer = grid.GetNode(2, 2);
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix(prefix);
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+  consumerHelper.Install(grid.GetNode(0, 0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+}
+
+static void
+SetupSit(const std::string& mapFile, uint32_t sitSize)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("2ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  // same parameters as in ndn-sit-test
+  RocketfuelParams params;
+  params.averageRtt = 2.0;
+  params.clientNodeDegrees = 2;
+  params.minb2bDelay = "1ms";
+  params.minb2bBandwidth = "10Mbps";
+  params.maxb2bDelay = "6ms";
+  params.maxb2bBandwidth = "100Mbps";
+  params.minb2gDelay = "1ms";
+  params.minb2gBandwidth = "10Mbps";
+  params.maxb2gDelay = "2ms";
+  params.maxb2gBandwidth = "50Mbps";
+  params.ming2cDelay = "1ms";
+  params.ming2cBandwidth = "1Mbps";
+  params.maxg2cDelay = "3ms";
+  params.maxg2cBandwidth = "10Mbps";
+
+  RocketfuelMapReader topologyReader("", 10);
+  topologyReader.SetFileName(mapFile);
+  NodeContainer nodes = topologyReader.Read(params, true, true);
+  NS_ABORT_MSG_IF(nodes.GetN() == 0, "Cannot read Rocketfuel map " << mapFile);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+  ndnHelper.setFibNumericRoot("/prefix");
+  ndnHelper.Install(nodes);
+
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/pickone");
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ApplicationContainer consumers;
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerSit");
+    consumerHelper.SetPrefix("/prefix");
+    consumers.Add(consumerHelper.Install(nodes.Get(i)));
+
+    ndn::Name prefix("/prefix");
+    prefix.appendNumber(i);
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix(prefix.toUri());
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(nodes.Get(i));
+    ndnGlobalRoutingHelper.AddOrigins(prefix.toUri(), nodes.Get(i));
+  }
+
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    ndn::L3Protocol::getL3Protocol(nodes.Get(i))->getForwarder()->setSitCapacity(sitSize);
+  }
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  ndn::AppHelper workloadHelper("ns3::ndn::WorkloadGenerator");
+  workloadHelper.SetAttribute("NumberOfContents", UintegerValue(1000));
+  workloadHelper.SetAttribute("s", DoubleValue(0.8));
+  workloadHelper.SetAttribute("ArrivalRate", DoubleValue(20.0));
+  workloadHelper.SetAttribute("NumChunks", UintegerValue(10));
+  workloadHelper.SetAttribute("ScopeIncrement", UintegerValue(1));
+  workloadHelper.SetAttribute("InitGap", TimeValue(Seconds(1.0)));
+  ApplicationContainer workload = workloadHelper.Install(nodes.Get(0));
+
+  Ptr<ndn::WorkloadGenerator> generator = DynamicCast<ndn::WorkloadGenerator>(workload.Get(0));
+  generator->SetConsumers(consumers);
+  generator->SetProducerNodes(nodes);
+  generator->AssignStreams(1000);
+  workload.Start(Seconds(0.2));
+}
+
+static uint64_t
+GetInterestsForwarded()
+{
+  uint64_t nInterests = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<ndn::L3Protocol> l3 = (*node)->GetObject<ndn::L3Protocol>();
+    if (l3 != 0) {
+      nInterests += l3->getForwarder()->getCounters().getNOutInterests();
+    }
+  }
+  return nInterests;
+}
+
+static int64_t
+GetPeakRss()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#ifdef __APPLE__
+  return usage.ru_maxrss;
+#else
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string scenario;
+  std::string output = "-";
+  double stopTime = 20.0;
+  uint32_t sitSize = 1000;
+  std::string mapFile = "src/ndnSIM/benchmarks/topologies/rocketfuel-bench.cch";
+
+  CommandLine cmd;
+  cmd.AddValue("scenario", "Scenario to run: tree, grid, sit, or nosit", scenario);
+  cmd.AddValue("output", "File to append the JSON result to (- for standard output)", output);
+  cmd.AddValue("stopTime", "Simulated time in seconds", stopTime);
+  cmd.AddValue("sitSize", "SIT capacity in the sit scenario", sitSize);
+  cmd.AddValue("map", "Rocketfuel map for the sit and nosit scenarios", mapFile);
+  cmd.Parse(argc, argv);
+
+  // results must not depend on --RngRun or environment
+  RngSeedManager::SetSeed(1);
+  RngSeedManager::SetRun(1);
+
+  ObjectFactory scheduler;
+  scheduler.SetTypeId(CountingMapScheduler::GetTypeId());
+  Simulator::SetScheduler(scheduler);
+
+  if (scenario == "tree") {
+    SetupTree();
+  }
+  else if (scenario == "grid") {
+    SetupGrid();
+  }
+  else if (scenario == "sit") {
+    SetupSit(mapFile, sitSize);
+  }
+  else if (scenario == "nosit") {
+    SetupSit(mapFile, 0);
+  }
+  else {
+    std::cerr << "Usage: ndn-benchmark --scenario=<tree|grid|sit|nosit> [--output=<file>] "
+                 "[--stopTime=<seconds>]" << std::endl;
+    return 2;
+  }
+
+  Simulator::Stop(Seconds(stopTime));
+
+  CountingMapScheduler::s_nEvents = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  double wallTime =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  uint64_t nEvents = CountingMapScheduler::s_nEvents;
+  uint64_t nInterests = GetInterestsForwarded();
+  int64_t peakRss = GetPeakRss();
+  Simulator::Destroy();
+
+  std::ofstream file;
+  if (output != "-") {
+    file.open(output.c_str(), std::ios_base::out | std::ios_base::app);
+    if (!file.is_open()) {
+      std::cerr << "ERROR: cannot open " << output << " for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& os = output != "-" ? file : std::cout;
+
+  os << "{\"scenario\": \"" << scenario << "\""
+     << ", \"stopTime\": " << stopTime
+     << ", \"wallTime\": " << wallTime
+     << ", \"events\": " << nEvents
+     << ", \"eventsPerSecond\": " << (wallTime > 0 ? nEvents / wallTime : 0)
+     << ", \"interestsForwarded\": " << nInterests
+     << ", \"interestsPerSecond\": " << (wallTime > 0 ? nInterests / wallTime : 0)
+     << ", \"peakRss\": " << peakRss << "}" << std::endl;
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,455 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-microbenchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cfib.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-builder.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+/**
+ * Microbenchmarks of NFD tables, ndnSIM content stores, and Interest/Data encoding
+ *
+ * Every benchmark performs --ops operations on names shaped as in the SIT workload,
+ * /prefix/<p>/<seq> with --prefixes distinct values of p, and reports the average wall-clock
+ * time (ns/op), the throughput (ops/s), and the average number of heap allocations (allocs/op)
+ * per operation.  Names, packets, and tables are prepared before the measurement starts.
+ *
+ *     ./waf --run "ndn-microbenchmark --filter=Pit --output=micro.json"
+ *
+ * With --output, results are appended to the file as one JSON object per line.
+ */
+
+/// @cond include_hidden
+
+// every heap allocation of the process goes through these, the benchmark is single-threaded
+static uint64_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  g_nAllocations++;
+  void* p = std::malloc(size != 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void*
+operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+/// @endcond
+
+namespace ns3 {
+namespace ndn {
+
+/// @cond include_hidden
+
+class MicroBenchmark {
+public:
+  MicroBenchmark(const std::string& filter, const std::string& output)
+    : m_filter(filter)
+  {
+    if (!output.empty()) {
+      m_output.open(output.c_str(), std::ios_base::out | std::ios_base::app);
+    }
+
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::right << std::setw(12)
+              << "ns/op" << std::setw(14) << "ops/s" << std::setw(12) << "allocs/op" << std::endl;
+  }
+
+  bool
+  IsSelected(const std::string& name) const
+  {
+    return m_filter.empty() || name.find(m_filter) != std::string::npos;
+  }
+
+  /**
+   * \brief Run op(i) for i in [0, nOps) and report time and allocations per operation
+   */
+  template<class Op>
+  void
+  Measure(const std::string& name, uint64_t nOps, Op op)
+  {
+    if (!IsSelected(name) || nOps == 0) {
+      return;
+    }
+
+    uint64_t nAllocations = g_nAllocations;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < nOps; i++) {
+      op(i);
+    }
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    nAllocations = g_nAllocations - nAllocations;
+
+    double nsPerOp = std::chrono::duration<double, std::nano>(stop - start).count() / nOps;
+    double opsPerSecond = nsPerOp > 0 ? 1e9 / nsPerOp : 0;
+    double allocsPerOp = static_cast<double>(nAllocations) / nOps;
+
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << nsPerOp << std::setprecision(0)
+              << std::setw(14) << opsPerSecond << std::setprecision(2) << std::setw(12)
+              << allocsPerOp << std::endl;
+
+    if (m_output.is_open()) {
+      m_output << "{\"benchmark\": \"" << name << "\", \"ops\": " << nOps
+               << ", \"nsPerOp\": " << nsPerOp << ", \"opsPerSecond\": " << opsPerSecond
+               << ", \"allocsPerOp\": " << allocsPerOp << "}" << std::endl;
+    }
+  }
+
+private:
+  std::string m_filter;
+  std::ofstream m_output;
+};
+
+/**
+ * \brief Names, Interests, and Data packets of the /prefix/<p>/<seq> workload
+ */
+struct Workload {
+  Workload(uint64_t nOps, uint32_t nPrefixes)
+  {
+    names.reserve(nOps);
+    interests.reserve(nOps);
+    data.reserve(nOps);
+
+    for (uint64_t i = 0; i < nOps; i++) {
+      Name name("/prefix");
+      name.appendNumber(i % nPrefixes);
+      name.appendSequenceNumber(i / nPrefixes);
+      names.push_back(name);
+
+      auto interest = make_shared<Interest>(name);
+      interest->setNonce(static_cast<uint32_t>(i));
+      interest->setInterestLifetime(time::seconds(2));
+      interest->wireEncode();
+      interests.push_back(interest);
+
+      data.push_back(MakeData(name));
+    }
+
+    for (uint32_t p = 0; p < nPrefixes; p++) {
+      Name prefix("/prefix");
+      prefix.appendNumber(p);
+      prefixes.push_back(prefix);
+    }
+  }
+
+  static shared_ptr<Data>
+  MakeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(make_shared< ::ndn::Buffer>(1024));
+
+    // same fake signature as the Producer app
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  std::vector<Name> names;
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+  std::vector<Name> prefixes;
+};
+
+static void
+BenchmarkNameTree(MicroBenchmark& bench, const Workload& workload)
+{
+  uint64_t nOps = workload.names.size();
+  nfd::NameTree nameTree;
+  std::vector<shared_ptr<nfd::name_tree::Entry>> entries(nOps);
+
+  bench.Measure("NameTree.Insert", nOps, [&] (uint64_t i) {
+    entries[i] = nameTree.lookup(workload.names[i]);
+  });
+
+  bench.Measure("NameTree.FindExactMatch", nOps, [&] (uint64_t i) {
+    nameTree.findExactMatch(workload.names[i]);
+  });
+
+  bench.Measure("NameTree.Erase", nOps, [&] (uint64_t i) {
+    nameTree.eraseEntryIfEmpty(entries[i]);
+    entries[i].reset();
+  });
+
+  // FIB-like lookups: only producer prefixes are in the tree
+  for (const Name& prefix : workload.prefixes) {
+    nameTree.lookup(prefix);
+  }
+  bench.Measure("NameTree.FindLongestPrefixMatch", nOps, [&] (uint64_t i) {
+    nameTree.findLongestPrefixMatch(workload.names[i]);
+  });
+}
+
+static void
+BenchmarkPit(MicroBenchmark& bench, const Workload& workload)
+{
+  uint64_t nOps = workload.names.size();
+  nfd::NameTree nameTree;
+  nfd::Pit pit(nameTree);
+  std::vector<shared_ptr<nfd::pit::Entry>> entries(nOps);
+
+  bench.Measure("Pit.Insert", nOps, [&] (uint64_t i) {
+    entries[i] = pit.insert(*workload.interests[i]).first;
+  });
+
+  bench.Measure("Pit.DataMatch", nOps, [&] (uint64_t i) {
+    pit.findAllDataMatches(*workload.data[i]);
+  });
+
+  bench.Measure("Pit.Erase", nOps, [&] (uint64_t i) {
+    pit.erase(entries[i]);
+    entries[i].reset();
+  });
+}
+
+static void
+BenchmarkCfib(MicroBenchmark& bench, const Workload& workload, size_t capacity)
+{
+  uint64_t nOps = workload.names.size();
+  nfd::NameTree nameTree;
+  nfd::Cfib sit(nameTree, capacity);
+  auto face = make_shared<nfd::NullFace>();
+
+  // the forwarder adds a next hop to every SIT entry it creates; once the capacity is
+  // reached, every insert evicts the least recently used entry
+  bench.Measure("Cfib.Put", nOps, [&] (uint64_t i) {
+    sit.insert(workload.names[i]).first->addNextHop(face, 0);
+  });
+
+  // the most recent entries are still in the cache
+  uint64_t nHits = std::min<uint64_t>(nOps, capacity);
+  bench.Measure("Cfib.Get", nHits, [&] (uint64_t i) {
+    sit.findExactMatch(workload.names[nOps - 1 - i]);
+  });
+
+  bench.Measure("Cfib.GetMiss", nOps - nHits, [&] (uint64_t i) {
+    sit.findExactMatch(workload.names[i]);
+  });
+}
+
+static void
+BenchmarkNfdCs(MicroBenchmark& bench, const Workload& workload, size_t capacity)
+{
+  uint64_t nOps = workload.names.size();
+  nfd::Cs cs(capacity);
+  uint64_t nHits = 0;
+
+  bench.Measure("nfd::Cs.Insert", nOps, [&] (uint64_t i) {
+    cs.insert(*workload.data[i]);
+  });
+
+  bench.Measure("nfd::Cs.Find", nOps, [&] (uint64_t i) {
+    cs.find(*workload.interests[i],
+            [&] (const Interest&, const Data&) { nHits++; },
+            [] (const Interest&) {});
+  });
+}
+
+static void
+BenchmarkContentStore(MicroBenchmark& bench, const Workload& workload, size_t capacity)
+{
+  uint64_t nOps = workload.names.size();
+  const char* policies[] = {"Lru", "Fifo", "Random", "Lfu"};
+
+  for (const char* policy : policies) {
+    std::string name = std::string("ContentStore.") + policy;
+    if (!bench.IsSelected(name)) {
+      continue;
+    }
+
+    ObjectFactory factory;
+    factory.SetTypeId(std::string("ns3::ndn::cs::") + policy);
+    factory.Set("MaxSize", StringValue(std::to_string(capacity)));
+    Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+    bench.Measure(name + ".Add", nOps, [&] (uint64_t i) {
+      cs->Add(workload.data[i]);
+    });
+
+    bench.Measure(name + ".Lookup", nOps, [&] (uint64_t i) {
+      cs->Lookup(workload.interests[i]);
+    });
+  }
+}
+
+static void
+BenchmarkDeadNonceList(MicroBenchmark& bench, const Workload& workload)
+{
+  uint64_t nOps = workload.names.size();
+  nfd::DeadNonceList dnl;
+
+  bench.Measure("DeadNonceList.Add", nOps, [&] (uint64_t i) {
+    dnl.add(workload.names[i], static_cast<uint32_t>(i));
+  });
+
+  bench.Measure("DeadNonceList.Has", nOps, [&] (uint64_t i) {
+    dnl.has(workload.names[i], static_cast<uint32_t>(i));
+  });
+}
+
+static void
+BenchmarkEncoding(MicroBenchmark& bench, const Workload& workload)
+{
+  uint64_t nOps = workload.names.size();
+  uint32_t nPrefixes = workload.prefixes.size();
+  Name prefix("/prefix");
+
+  // how consumer apps create the name of every Interest
+  bench.Measure("Name.Append", nOps, [&] (uint64_t i) {
+    Name name(prefix);
+    name.appendNumber(i % nPrefixes);
+    name.appendSequenceNumber(i / nPrefixes);
+  });
+
+  NameBuilder builder;
+  bench.Measure("Name.Build", nOps, [&] (uint64_t i) {
+    builder.SetPrefix(prefix);
+    builder.AppendNumber(i % nPrefixes).AppendSequenceNumber(i / nPrefixes).Build();
+  });
+
+  bench.Measure("Interest.Encode", nOps, [&] (uint64_t i) {
+    Interest interest(workload.names[i]);
+    interest.setNonce(static_cast<uint32_t>(i));
+    interest.setInterestLifetime(time::seconds(2));
+    interest.wireEncode();
+  });
+
+  bench.Measure("Interest.Decode", nOps, [&] (uint64_t i) {
+    Interest interest(workload.interests[i]->wireEncode());
+    interest.getName();
+  });
+
+  // same Interests with elements in the order of the NDN packet specification (flags after the
+  // other elements), which cannot be decoded in a single pass
+  std::vector<Block> reordered;
+  if (bench.IsSelected("Interest.DecodeReordered")) {
+    reordered.reserve(nOps);
+    for (const shared_ptr<Interest>& interest : workload.interests) {
+      const Block& wire = interest->wireEncode();
+      wire.parse();
+      Block block(::ndn::tlv::Interest);
+      for (const Block& element : wire.elements()) {
+        if (element.type() != ::ndn::tlv::FloodFlag
+            && element.type() != ::ndn::tlv::DestinationFlag) {
+          block.push_back(element);
+        }
+      }
+      block.push_back(wire.get(::ndn::tlv::DestinationFlag));
+      block.push_back(wire.get(::ndn::tlv::FloodFlag));
+      block.encode();
+      reordered.push_back(block);
+    }
+  }
+  bench.Measure("Interest.DecodeReordered", reordered.size(), [&] (uint64_t i) {
+    Interest interest(reordered[i]);
+    interest.getName();
+  });
+
+  bench.Measure("Data.Encode", nOps, [&] (uint64_t i) {
+    Workload::MakeData(workload.names[i]);
+  });
+
+  bench.Measure("Data.Decode", nOps, [&] (uint64_t i) {
+    Data data(workload.data[i]->wireEncode());
+    data.getContent();
+  });
+}
+
+/// @endcond
+
+} // namespace ndn
+
+int
+main(int argc, char* argv[])
+{
+  uint64_t nOps = 100000;
+  uint32_t nPrefixes = 100;
+  uint32_t capacity = 10000;
+  std::string filter;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue("ops", "Number of operations per benchmark", nOps);
+  cmd.AddValue("prefixes", "Number of distinct producer prefixes /prefix/<p>", nPrefixes);
+  cmd.AddValue("capacity", "Capacity of the SIT and content stores", capacity);
+  cmd.AddValue("filter", "Run only benchmarks whose name contains this string", filter);
+  cmd.AddValue("output", "File to append JSON results to", output);
+  cmd.Parse(argc, argv);
+
+  ndn::Workload workload(nOps, std::max<uint32_t>(nPrefixes, 1));
+  ndn::MicroBenchmark bench(filter, output);
+
+  ndn::BenchmarkNameTree(bench, workload);
+  ndn::BenchmarkPit(bench, workload);
+  ndn::BenchmarkCfib(bench, workload, capacity);
+  ndn::BenchmarkNfdCs(bench, workload, capacity);
+  ndn::BenchmarkContentStore(bench, workload, capacity);
+  ndn::BenchmarkDeadNonceList(bench, workload);
+  ndn::BenchmarkEncoding(bench, workload);
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,176 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""Run ndnSIM throughput benchmarks and compare them against stored baselines.
+
+Must be started from the ns-3 root directory, with ndnSIM configured with --enable-examples:
+
+    ./src/ndnSIM/benchmarks/run-benchmarks.py --output=bench-results.json
+
+Every scenario runs in a separate ndn-benchmark process.  Results of all scenarios are
+written to --output as a single JSON object keyed by the scenario name.
+
+Metrics that depend only on the simulated scenario (events, interestsForwarded) are compared
+with --baselines, which is part of the source tree.  They must match exactly: a mismatch, or a
+missing baseline, means the simulated behavior has changed (or has never been recorded) and
+the script exits with status 1.  Timing metrics are compared with --timing-baselines, which
+is specific to the machine and not part of the source tree.  When a timing result is worse
+than its baseline by more than --tolerance (relative), the regression is reported and the
+script exits with status 1.
+
+--update writes the results as the new baselines to both files.  Commit the updated
+--baselines only when the change of the simulated behavior is intended.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+SCENARIOS = ['tree', 'grid', 'sit', 'nosit']
+
+# metric -> True when higher is better
+TIMING_METRICS = {
+    'wallTime': False,
+    'eventsPerSecond': True,
+    'interestsPerSecond': True,
+    'peakRss': False,
+}
+
+EXACT_METRICS = ['events', 'interestsForwarded']
+
+DEFAULT_BASELINES = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'baselines.json')
+DEFAULT_TIMING_BASELINES = 'bench-timing-baselines.json'
+
+
+def run_scenario(waf, scenario, stop_time):
+    fd, path = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    try:
+        command = 'ndn-benchmark --scenario=%s --stopTime=%s --output=%s' % (scenario, stop_time,
+                                                                           path)
+        subprocess.check_call([waf, '--run', command])
+        with open(path) as f:
+            return json.loads(f.readline())
+    finally:
+        os.remove(path)
+
+
+def compare_exact(scenario, result, baseline):
+    failures = []
+    if baseline is None:
+        print('%s: no baseline, run with --update to record one' % scenario)
+        return [(scenario, 'baseline')]
+    if baseline.get('stopTime') != result['stopTime']:
+        print('%s: baseline was recorded with stopTime=%s, skipping comparison'
+              % (scenario, baseline.get('stopTime')))
+        return failures
+
+    for metric in EXACT_METRICS:
+        if baseline.get(metric) is None:
+            print('%s: %s baseline has not been recorded, run with --update to record it'
+                  % (scenario, metric))
+            failures.append((scenario, metric))
+        elif baseline[metric] != result[metric]:
+            print('%s: %s changed from %s to %s (simulated behavior differs from the baseline)'
+                  % (scenario, metric, baseline[metric], result[metric]))
+            failures.append((scenario, metric))
+    return failures
+
+
+def compare_timing(scenario, result, baseline, tolerance):
+    regressions = []
+    if baseline is None:
+        print('%s: no timing baseline on this machine, run with --update to record one'
+              % scenario)
+        return regressions
+    if baseline.get('stopTime') != result['stopTime']:
+        print('%s: timing baseline was recorded with stopTime=%s, skipping comparison'
+              % (scenario, baseline.get('stopTime')))
+        return regressions
+
+    for metric, higher_is_better in sorted(TIMING_METRICS.items()):
+        if metric not in baseline or baseline[metric] <= 0 or result[metric] < 0:
+            continue
+        change = (result[metric] - baseline[metric]) / float(baseline[metric])
+        worse = -change if higher_is_better else change
+        status = 'REGRESSION' if worse > tolerance else 'ok'
+        print('%-6s %-20s %14.2f %14.2f %+7.1f%%  %s'
+              % (scenario, metric, baseline[metric], result[metric], change * 100, status))
+        if worse > tolerance:
+            regressions.append((scenario, metric))
+    return regressions
+
+
+def load_baselines(path):
+    if not os.path.exists(path):
+        return {}
+    with open(path) as f:
+        return json.load(f)
+
+
+def save_baselines(path, baselines):
+    with open(path, 'w') as f:
+        json.dump(baselines, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+
+def select(result, metrics):
+    selected = dict((metric, result[metric]) for metric in metrics)
+    selected['stopTime'] = result['stopTime']
+    return selected
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run ndnSIM throughput benchmarks')
+    parser.add_argument('--scenario', action='append', choices=SCENARIOS,
+                        help='scenario to run (can be repeated, default: all)')
+    parser.add_argument('--stop-time', default='20', help='simulated time in seconds')
+    parser.add_argument('--waf', default='./waf', help='path to waf in the ns-3 root directory')
+    parser.add_argument('--output', default='bench-results.json', help='results file')
+    parser.add_argument('--baselines', default=DEFAULT_BASELINES,
+                        help='baselines of the simulated behavior (part of the source tree)')
+    parser.add_argument('--timing-baselines', default=DEFAULT_TIMING_BASELINES,
+                        help='timing baselines of this machine')
+    parser.add_argument('--tolerance', type=float, default=0.10,
+                        help='allowed relative slowdown before a result is a regression')
+    parser.add_argument('--update', action='store_true',
+                        help='store the results as the new baselines')
+    args = parser.parse_args()
+
+    results = {}
+    for scenario in args.scenario or SCENARIOS:
+        results[scenario] = run_scenario(args.waf, scenario, args.stop_time)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+    baselines = load_baselines(args.baselines)
+    timing_baselines = load_baselines(args.timing_baselines)
+
+    if args.update:
+        for scenario, result in results.items():
+            baselines[scenario] = select(result, EXACT_METRICS)
+            timing_baselines[scenario] = select(result, TIMING_METRICS)
+        save_baselines(args.baselines, baselines)
+        save_baselines(args.timing_baselines, timing_baselines)
+        print('Baselines updated in %s and %s' % (args.baselines, args.timing_baselines))
+        return 0
+
+    failures = []
+    for scenario in sorted(results):
+        failures += compare_exact(scenario, results[scenario], baselines.get(scenario))
+        failures += compare_timing(scenario, results[scenario], timing_baselines.get(scenario),
+                                   args.tolerance)
+
+    if failures:
+        print('%d failure(s): %s' % (len(failures), ', '.join('%s/%s' % f for f in failures)))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
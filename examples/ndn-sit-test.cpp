@@ -50,6 +50,10 @@
 // for generating Zipf distributed content
 #include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
 
+// for generating requests lazily during the simulation
+#include "ns3/ndnSIM/apps/ndn-workload-generator.hpp"
+#include "ns3/ndnSIM/apps/ndn-trace-replay.hpp"
+
 #include "ns3/log.h"
 
 // for obtaining forwarder of a node
@@ -116,25 +120,18 @@ TargetType convert(const std::string& value)
 
 uint32_t get_cost(NodeContainer &nodes, uint32_t app_indx, uint32_t producer_indx)
 {
-  uint32_t cost;
-  Ptr<Node> n = nodes.Get(app_indx);
-  Ptr<ndn::L3Protocol> p =  ndn::L3Protocol::getL3Protocol(n);
-  shared_ptr<nfd::Forwarder> f = p->getForwarder();
-  ndn::Name name("/prefix");
-  name.appendNumber(producer_indx);
-  if(f->getFib().findLongestPrefixMatch(name)->hasNextHops())
-    cost = f->getFib().findLongestPrefixMatch(name)->getNextHops()[0].getCost();
-  else
+  // path costs are recorded by GlobalRoutingHelper::CalculateRoutes, no FIB lookups needed
+  uint32_t cost = ndn::GlobalRoutingHelper::GetPathCost(nodes.Get(app_indx), nodes.Get(producer_indx));
+  if (cost == ndn::GlobalRoutingHelper::UNREACHABLE)
   {
     cost = 0;
   }
-  //NS_LOG_INFO("Cost to "<<name<<" is "<<cost);
-  NS_LOG_DEBUG("Cost to "<<name<<" from "<<app_indx<<" is "<<cost);
+  NS_LOG_DEBUG("Cost to /prefix/"<<producer_indx<<" from "<<app_indx<<" is "<<cost);
 
   return cost;
 }
 
-void Schedule_Send(ApplicationContainer consumer_apps, uint32_t app_indx, double connect_time, uint32_t producer_indx, uint32_t scoped_downstream_counter, uint32_t content_indx, uint32_t num_chunks)
+void Schedule_Send(ApplicationContainer consumer_apps, uint32_t app_indx, double connect_time, uint32_t producer_indx, uint32_t scoped_downstream_counter, uint32_t content_indx, uint32_t num_chunks, bool pipelined)
 {
   double interpacket = 0.008192; //num. of secs btw outgoing packets (i.e. 1024bytes/10_Mbits/sec)
     
@@ -145,6 +142,12 @@ void Schedule_Send(ApplicationContainer consumer_apps, uint32_t app_indx, double
   ndn::ConsumerSit *cons = reinterpret_cast<ndn::ConsumerSit *>(app_ptr);
   if (!static_cast<bool> (cons) )
     NS_LOG_INFO("cons is null ");
+  if (pipelined)
+  {
+    // the consumer paces the chunks with its congestion window
+    Simulator::Schedule(Seconds(connect_time), &ndn::ConsumerSit::RequestContent, cons, producer_indx, content_indx, num_chunks, scoped_downstream_counter);
+    return;
+  }
   //NS_LOG_INFO("App_indx: "<<app_indx<<" producer_indx: "<<producer_indx<<" num_chunks "<<num_chunks<<" connect_time "<<connect_time);
   for (uint32_t chunk = content_indx; chunk < content_indx + num_chunks; chunk++)
   {
@@ -153,6 +156,11 @@ void Schedule_Send(ApplicationContainer consumer_apps, uint32_t app_indx, double
   }
 }
 
+void Flow_Completed(Ptr<ndn::App> app, uint32_t producer_indx, uint32_t content_indx, uint32_t num_chunks, Time completion_time)
+{
+  NS_LOG_INFO("Flow completed: node " << app->GetNode()->GetId() << " content " << producer_indx << "/" << content_indx << " chunks " << num_chunks << " time " << completion_time.GetSeconds());
+}
+
 // Run with: NS_LOG=ndn.Consumer=info:SitTest=info:ndn.cs.Lru=info:nfd.FibManager=info:nfd.Forwarder=info:nfd.Cfib=info:nfd.FibEntry=info
 int
 main(int argc, char* argv[])
@@ -181,6 +189,12 @@ main(int argc, char* argv[])
   uint32_t num_chunks = 1;
   std::string strategy;
   uint32_t sit_size = 0;
+  std::string topology_cache;
+  std::string route_cache;
+  bool streaming_workload = false;
+  std::string request_trace;
+  bool pipelined = false;
+  bool numeric_fib = false;
 
   if(argc < 12)
   {
@@ -206,6 +220,12 @@ main(int argc, char* argv[])
   cmd.AddValue ("num_chunks", "Number of chunks each flow requests", num_chunks);
   cmd.AddValue ("strategy", "Forwarding strategy: send to all or one", strategy);
   cmd.AddValue ("sit_size", "SIT table size", sit_size);
+  cmd.AddValue ("topology_cache", "Compiled topology cache file (empty to disable)", topology_cache);
+  cmd.AddValue ("route_cache", "Computed routes cache file (empty to disable)", route_cache);
+  cmd.AddValue ("streaming_workload", "Generate requests during the simulation instead of scheduling all of them upfront", streaming_workload);
+  cmd.AddValue ("request_trace", "Binary request trace to replay instead of the synthetic workload", request_trace);
+  cmd.AddValue ("pipelined", "Fetch chunks with the congestion window of the consumer instead of a fixed interval", pipelined);
+  cmd.AddValue ("numeric_fib", "Keep FIB entries of producer prefixes /prefix/<node> in a direct-indexed array", numeric_fib);
   cmd.Parse(argc, argv);
   
 // Prepare the Topology
@@ -230,7 +250,11 @@ main(int argc, char* argv[])
   RocketfuelMapReader topo_reader("", 10);
   std::string topo_file_name = "/home/uceeoas/maps/" + topology_file;
   topo_reader.SetFileName(topo_file_name);
-  NodeContainer nodes = topo_reader.Read(params, true, true);
+  NodeContainer nodes;
+  if (topology_cache.empty())
+    nodes = topo_reader.Read(params, true, true);
+  else
+    nodes = topo_reader.ReadCached(topology_cache, params, true, true);
 //*/
   // Read network (infrastructure) topology from a file 
   /*
@@ -251,6 +275,7 @@ main(int argc, char* argv[])
   NS_LOG_INFO("Number of chunks "<<num_chunks);
   NS_LOG_INFO("Strategy: "<<strategy);
   NS_LOG_INFO("Sit_size: "<<sit_size);
+  NS_LOG_INFO("Numeric_fib: "<<numeric_fib);
   NS_LOG_INFO("End_of_Params");
 
   NS_LOG_INFO("Number_of_infrastructure_nodes: "<<nodes.GetN()); 
@@ -270,6 +295,11 @@ main(int argc, char* argv[])
   {
     ndnHelperCaching.SetOldContentStore("ns3::ndn::cs::Probability::Lru", "MaxSize", std::to_string(cache_size), "CacheProbability", std::to_string(probability));
   }
+  // producer prefixes are /prefix/<node>, optionally keep their FIB entries in a direct-indexed array
+  if (numeric_fib)
+  {
+    ndnHelperCaching.setFibNumericRoot("/prefix");
+  }
   ndnHelperCaching.Install(nodes);
 
   //ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route/%FD%03"); //multicast strategy
@@ -337,10 +367,56 @@ main(int argc, char* argv[])
     }
   }
   // Calculate and install FIBs
-  ndn::GlobalRoutingHelper::CalculateRoutes();
+  if (route_cache.empty())
+    ndn::GlobalRoutingHelper::CalculateRoutes();
+  else
+    ndn::GlobalRoutingHelper::CalculateRoutes(route_cache);
   std::this_thread::sleep_for(std::chrono::seconds(2));
+  diameter = ndn::GlobalRoutingHelper::GetDiameter();
   /****************************************************************/
   //Setup Simulation Events (connection, disconnection, etc)
+  if (pipelined)
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerSit/FlowCompletion", MakeCallback(&Flow_Completed));
+
+  if (!request_trace.empty())
+  {
+    ndn::AppHelper replayHelper("ns3::ndn::TraceReplay");
+    replayHelper.SetAttribute("TraceFile", StringValue(request_trace));
+    if (pipelined)
+      replayHelper.SetAttribute("ChunkInterval", TimeValue(Seconds(0)));
+    ApplicationContainer replay = replayHelper.Install(nodes.Get(0));
+    DynamicCast<ndn::TraceReplay>(replay.Get(0))->SetConsumers(consumer_apps);
+
+    Simulator::Stop(Seconds(simulation_length));
+    Simulator::Run();
+    Simulator::Destroy();
+    return 0;
+  }
+
+  if (streaming_workload)
+  {
+    // Same workload as below, but each arrival is drawn only when the previous one fires
+    ndn::AppHelper workloadHelper("ns3::ndn::WorkloadGenerator");
+    workloadHelper.SetAttribute("NumberOfContents", UintegerValue(num_contents));
+    workloadHelper.SetAttribute("s", DoubleValue(zipf_exponent));
+    workloadHelper.SetAttribute("ArrivalRate", DoubleValue(connection_rate));
+    workloadHelper.SetAttribute("NumChunks", UintegerValue(num_chunks));
+    workloadHelper.SetAttribute("ScopeIncrement", UintegerValue(scoped_downstream_counter));
+    workloadHelper.SetAttribute("ObservationLength", TimeValue(Seconds(simulation_length)));
+    workloadHelper.SetAttribute("DrainTime", TimeValue(Seconds(2)));
+    if (pipelined)
+      workloadHelper.SetAttribute("ChunkInterval", TimeValue(Seconds(0)));
+    ApplicationContainer workload = workloadHelper.Install(nodes.Get(0));
+    Ptr<ndn::WorkloadGenerator> generator = DynamicCast<ndn::WorkloadGenerator>(workload.Get(0));
+    generator->SetConsumers(consumer_apps);
+    generator->SetProducerNodes(nodes);
+    workload.Start(Seconds(0.2));
+
+    NS_LOG_INFO("Graph Diameter: "<<diameter);
+    Simulator::Run();
+    Simulator::Destroy();
+    return 0;
+  }
 
   // Content Distribution 
   ndn::ConsumerZipfMandelbrot content_dist(num_contents, 0, zipf_exponent);
@@ -359,10 +435,7 @@ main(int argc, char* argv[])
     uint32_t producer_indx = content_indx%(producer_apps.GetN());
     uint32_t app_indx = rnd_gen()%(consumer_apps.GetN());
     uint32_t cost = get_cost(nodes, app_indx, producer_indx);
-    if(cost > diameter){
-      diameter = cost;
-    }
-	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks);
+	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks, pipelined);
 	 num_connected++;
     if(cost == 0 && (app_indx != producer_indx)){
       std::cout<<"This should not happen; cost is 0 for different nodes\n";
@@ -391,7 +464,7 @@ main(int argc, char* argv[])
     uint32_t producer_indx = content_indx%(producer_apps.GetN());
     uint32_t app_indx = rnd_gen()%(consumer_apps.GetN());
     uint32_t cost = get_cost(nodes, app_indx, producer_indx);
-	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks);
+	 Schedule_Send(consumer_apps, app_indx, connect_time, producer_indx, cost + scoped_downstream_counter, content_indx, num_chunks, pipelined);
 	 num_connected++;
     connect_time = connect_time + rng_exp_con(rnd_gen);
     if(!requested_content[content_indx])
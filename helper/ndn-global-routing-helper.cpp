@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-face.hpp"
 #include "model/ndn-global-router.hpp"
+#include "utils/topology/compiled-topology.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -51,8 +52,14 @@
 #include <boost/foreach.hpp>
 #include <boost/concept/assert.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
 
@@ -63,6 +70,250 @@ NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 namespace ns3 {
 namespace ndn {
 
+/// @cond include_hidden
+
+/**
+ * @brief Dense node x origin matrix of path costs computed by CalculateRoutes
+ */
+struct PathCostMatrix {
+  void
+  reset(uint32_t nNodes)
+  {
+    nodes = nNodes;
+    originIndex.assign(nNodes, -1);
+    origins = 0;
+    costs.clear();
+    diameter = 0;
+  }
+
+  uint32_t nodes = 0;
+  uint32_t origins = 0;
+  std::vector<int32_t> originIndex; ///< node ID -> column, or -1 if node is not an origin
+  std::vector<uint32_t> costs;      ///< row-major, nodes x origins
+  uint32_t diameter = 0;
+};
+
+static PathCostMatrix g_pathCosts;
+
+/**
+ * @brief Binary route cache file
+ *
+ * Layout: header, origin index (int32 x nodes), path costs (uint32 x nodes x origins), route
+ * records, prefix offsets (uint32 x nPrefixes), and NUL-terminated prefix URIs.  Records are
+ * stored in the order routes have been added, so replaying them produces identical FIBs.
+ */
+struct RouteCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t nodes;
+  uint64_t fingerprint;
+  uint32_t origins;
+  uint32_t diameter;
+  uint32_t nRoutes;
+  uint32_t nPrefixes;
+  uint32_t stringsSize;
+  uint32_t reserved;
+};
+
+struct RouteRecord {
+  uint32_t node;
+  uint32_t faceId;
+  uint32_t prefix; ///< index in prefix offsets
+  uint32_t cost;
+};
+
+static const char ROUTE_CACHE_MAGIC[8] = {'N', 'D', 'N', 'R', 'O', 'U', 'T', 'E'};
+static const uint32_t ROUTE_CACHE_VERSION = 1;
+
+/**
+ * @brief Routes added by CalculateRoutes, recorded only when a route cache is being created
+ */
+struct RouteLog {
+  uint32_t
+  getPrefixIndex(const Name& prefix)
+  {
+    auto i = prefixIndex.find(&prefix);
+    if (i != prefixIndex.end())
+      return i->second;
+
+    uint32_t index = prefixes.size();
+    prefixes.push_back(prefix.toUri());
+    prefixIndex.insert(std::make_pair(&prefix, index));
+    return index;
+  }
+
+  std::vector<RouteRecord> routes;
+  std::vector<std::string> prefixes;
+  std::unordered_map<const Name*, uint32_t> prefixIndex;
+};
+
+static RouteLog* g_routeLog = nullptr;
+
+static bool
+loadRouteCache(const std::string& file, uint64_t fingerprint)
+{
+  boost::system::error_code error;
+  if (!boost::filesystem::is_regular_file(file, error)
+      || boost::filesystem::file_size(file, error) < sizeof(RouteCacheHeader)) {
+    return false;
+  }
+
+  boost::iostreams::mapped_file_source source;
+  try {
+    source.open(file);
+  }
+  catch (const std::exception& e) {
+    NS_LOG_WARN("Cannot map " << file << ": " << e.what());
+    return false;
+  }
+
+  const RouteCacheHeader* header = reinterpret_cast<const RouteCacheHeader*>(source.data());
+  if (std::memcmp(header->magic, ROUTE_CACHE_MAGIC, sizeof(ROUTE_CACHE_MAGIC)) != 0
+      || header->version != ROUTE_CACHE_VERSION || header->fingerprint != fingerprint
+      || header->nodes != NodeList::GetNNodes()) {
+    NS_LOG_INFO(file << " was created for a different topology or origins");
+    return false;
+  }
+
+  size_t nCosts = static_cast<size_t>(header->nodes) * header->origins;
+  size_t expectedSize = sizeof(RouteCacheHeader) + header->nodes * sizeof(int32_t)
+                        + nCosts * sizeof(uint32_t) + header->nRoutes * sizeof(RouteRecord)
+                        + header->nPrefixes * sizeof(uint32_t) + header->stringsSize;
+  if (expectedSize != source.size()) {
+    NS_LOG_WARN(file << " is truncated or corrupted");
+    return false;
+  }
+
+  const int32_t* originIndex = reinterpret_cast<const int32_t*>(header + 1);
+  const uint32_t* costs = reinterpret_cast<const uint32_t*>(originIndex + header->nodes);
+  const RouteRecord* routes = reinterpret_cast<const RouteRecord*>(costs + nCosts);
+  const uint32_t* prefixOffsets = reinterpret_cast<const uint32_t*>(routes + header->nRoutes);
+  const char* strings = reinterpret_cast<const char*>(prefixOffsets + header->nPrefixes);
+
+  std::vector<Name> prefixes;
+  prefixes.reserve(header->nPrefixes);
+  for (uint32_t i = 0; i < header->nPrefixes; i++) {
+    if (prefixOffsets[i] >= header->stringsSize) {
+      NS_LOG_WARN(file << " is corrupted");
+      return false;
+    }
+    prefixes.push_back(Name(strings + prefixOffsets[i]));
+  }
+
+  // resolve all faces first, so a stale file never leaves FIBs partially populated
+  std::vector<shared_ptr<Face>> faces(header->nRoutes);
+  for (uint32_t i = 0; i < header->nRoutes; i++) {
+    const RouteRecord& route = routes[i];
+    Ptr<L3Protocol> ndn = route.node < header->nodes ?
+                            NodeList::GetNode(route.node)->GetObject<L3Protocol>() : 0;
+    if (ndn == 0 || route.prefix >= header->nPrefixes) {
+      NS_LOG_WARN(file << " is corrupted");
+      return false;
+    }
+
+    faces[i] = ndn->getFaceById(route.faceId);
+    if (faces[i] == nullptr) {
+      NS_LOG_WARN("Face " << route.faceId << " on node " << route.node << " from " << file
+                          << " does not exist");
+      return false;
+    }
+  }
+
+  g_pathCosts.reset(header->nodes);
+  g_pathCosts.origins = header->origins;
+  g_pathCosts.originIndex.assign(originIndex, originIndex + header->nodes);
+  g_pathCosts.costs.assign(costs, costs + nCosts);
+  g_pathCosts.diameter = header->diameter;
+
+  // install next hops directly, the same way FibManager handles add-nexthop command
+  for (uint32_t i = 0; i < header->nRoutes; i++) {
+    const RouteRecord& route = routes[i];
+    Ptr<L3Protocol> ndn = NodeList::GetNode(route.node)->GetObject<L3Protocol>();
+    nfd::Fib& fib = ndn->getForwarder()->getFib();
+    fib.insert(prefixes[route.prefix]).first->addNextHop(faces[i], route.cost);
+  }
+
+  NS_LOG_INFO("Installed " << header->nRoutes << " routes from " << file);
+  return true;
+}
+
+static void
+saveRouteCache(const std::string& file, uint64_t fingerprint, const RouteLog& log)
+{
+  RouteCacheHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, ROUTE_CACHE_MAGIC, sizeof(ROUTE_CACHE_MAGIC));
+  header.version = ROUTE_CACHE_VERSION;
+  header.nodes = g_pathCosts.nodes;
+  header.fingerprint = fingerprint;
+  header.origins = g_pathCosts.origins;
+  header.diameter = g_pathCosts.diameter;
+  header.nRoutes = log.routes.size();
+  header.nPrefixes = log.prefixes.size();
+
+  std::vector<uint32_t> prefixOffsets;
+  std::string strings;
+  for (const std::string& prefix : log.prefixes) {
+    prefixOffsets.push_back(strings.size());
+    strings.append(prefix);
+    strings.push_back('\0');
+  }
+  header.stringsSize = strings.size();
+
+  // write to a temporary file with a unique name first and rename it into place, so concurrent
+  // runs neither read a partially written file nor write into each other's temporary file
+  boost::system::error_code error;
+  std::string tmpFile =
+    boost::filesystem::unique_path(file + ".%%%%-%%%%-%%%%.tmp", error).string();
+  if (error) {
+    NS_LOG_WARN("Cannot generate temporary file name for " << file << ": " << error.message());
+    return;
+  }
+
+  bool isWritten = false;
+  {
+    std::ofstream os(tmpFile.c_str(), std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+      NS_LOG_WARN("Cannot open " << tmpFile << " for writing");
+      return;
+    }
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!g_pathCosts.originIndex.empty())
+      os.write(reinterpret_cast<const char*>(&g_pathCosts.originIndex[0]),
+               g_pathCosts.originIndex.size() * sizeof(int32_t));
+    if (!g_pathCosts.costs.empty())
+      os.write(reinterpret_cast<const char*>(&g_pathCosts.costs[0]),
+               g_pathCosts.costs.size() * sizeof(uint32_t));
+    if (!log.routes.empty())
+      os.write(reinterpret_cast<const char*>(&log.routes[0]),
+               log.routes.size() * sizeof(RouteRecord));
+    if (!prefixOffsets.empty())
+      os.write(reinterpret_cast<const char*>(&prefixOffsets[0]),
+               prefixOffsets.size() * sizeof(uint32_t));
+    os.write(strings.data(), strings.size());
+
+    os.close();
+    isWritten = !os.fail();
+  }
+
+  if (!isWritten) {
+    NS_LOG_WARN("Failed to write " << tmpFile);
+    boost::filesystem::remove(tmpFile, error);
+    return;
+  }
+
+  boost::filesystem::rename(tmpFile, file, error);
+  if (error) {
+    NS_LOG_WARN("Cannot rename " << tmpFile << " to " << file << ": " << error.message());
+    boost::filesystem::remove(tmpFile, error);
+  }
+}
+
+/// @endcond
+
+const uint32_t GlobalRoutingHelper::UNREACHABLE;
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -228,6 +479,17 @@ GlobalRoutingHelper::CalculateRoutes()
   boost::NdnGlobalRouterGraph graph;
   // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
 
+  // columns of the path cost matrix: nodes that originate at least one prefix
+  g_pathCosts.reset(NodeList::GetNNodes());
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0 && !gr->GetLocalPrefixes().empty()) {
+      g_pathCosts.originIndex[(*node)->GetId()] = g_pathCosts.origins++;
+    }
+  }
+  g_pathCosts.costs.assign(static_cast<size_t>(g_pathCosts.nodes) * g_pathCosts.origins,
+                           UNREACHABLE);
+
   // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
   // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
   // the graph, which
@@ -239,6 +501,14 @@ GlobalRoutingHelper::CalculateRoutes()
       continue;
     }
 
+    uint32_t* costRow = g_pathCosts.origins > 0 ?
+                          &g_pathCosts.costs[static_cast<size_t>((*node)->GetId())
+                                             * g_pathCosts.origins] :
+                          nullptr;
+    if (g_pathCosts.originIndex[(*node)->GetId()] >= 0) {
+      costRow[g_pathCosts.originIndex[(*node)->GetId()]] = 0;
+    }
+
     boost::DistancesMap distances;
 
     dijkstra_shortest_paths(graph, source,
@@ -265,6 +535,13 @@ GlobalRoutingHelper::CalculateRoutes()
           // cout << " is unreachable" << endl;
         }
         else {
+          Ptr<Node> origin = dist.first->GetObject<Node>();
+          if (origin != 0 && g_pathCosts.originIndex[origin->GetId()] >= 0) {
+            uint32_t cost = std::get<1>(dist.second);
+            costRow[g_pathCosts.originIndex[origin->GetId()]] = cost;
+            g_pathCosts.diameter = std::max(g_pathCosts.diameter, cost);
+          }
+
           for (const auto& prefix : dist.first->GetLocalPrefixes()) {
             NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
                          << " with distance " << std::get<1>(dist.second) << " with delay "
@@ -272,6 +549,14 @@ GlobalRoutingHelper::CalculateRoutes()
 
             FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
                                 std::get<1>(dist.second));
+
+            if (g_routeLog != nullptr) {
+              RouteRecord route = {(*node)->GetId(),
+                                   static_cast<uint32_t>(std::get<0>(dist.second)->getId()),
+                                   g_routeLog->getPrefixIndex(*prefix),
+                                   std::get<1>(dist.second)};
+              g_routeLog->routes.push_back(route);
+            }
           }
         }
       }
@@ -279,6 +564,82 @@ GlobalRoutingHelper::CalculateRoutes()
   }
 }
 
+bool
+GlobalRoutingHelper::CalculateRoutes(const std::string& cacheFile)
+{
+  uint64_t fingerprint = GetRoutingFingerprint();
+  if (loadRouteCache(cacheFile, fingerprint))
+    return true;
+
+  RouteLog log;
+  g_routeLog = &log;
+  CalculateRoutes();
+  g_routeLog = nullptr;
+
+  saveRouteCache(cacheFile, fingerprint, log);
+  NS_LOG_INFO("Saved " << log.routes.size() << " routes to " << cacheFile);
+  return false;
+}
+
+uint64_t
+GlobalRoutingHelper::GetRoutingFingerprint()
+{
+  uint32_t nNodes = NodeList::GetNNodes();
+  uint64_t hash = CompiledTopology::Hash(&nNodes, sizeof(nNodes));
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr == 0)
+      continue;
+
+    uint32_t nodeId = (*node)->GetId();
+    hash = CompiledTopology::Hash(&nodeId, sizeof(nodeId), hash);
+
+    for (const auto& prefix : gr->GetLocalPrefixes()) {
+      // terminating NUL separates adjacent prefixes
+      std::string uri = prefix->toUri();
+      hash = CompiledTopology::Hash(uri.c_str(), uri.size() + 1, hash);
+    }
+
+    for (const auto& incidency : gr->GetIncidencies()) {
+      uint32_t edge[3] = {0, 0, 0}; // face ID, metric, other node ID
+      if (std::get<1>(incidency) != nullptr) {
+        edge[0] = std::get<1>(incidency)->getId();
+        edge[1] = std::get<1>(incidency)->getMetric();
+      }
+      edge[2] = std::get<2>(incidency)->GetObject<Node>()->GetId();
+      hash = CompiledTopology::Hash(edge, sizeof(edge), hash);
+    }
+  }
+
+  return hash;
+}
+
+uint32_t
+GlobalRoutingHelper::GetPathCost(uint32_t nodeId, uint32_t originNodeId)
+{
+  if (nodeId >= g_pathCosts.nodes || originNodeId >= g_pathCosts.nodes)
+    return UNREACHABLE;
+
+  int32_t column = g_pathCosts.originIndex[originNodeId];
+  if (column < 0)
+    return UNREACHABLE;
+
+  return g_pathCosts.costs[static_cast<size_t>(nodeId) * g_pathCosts.origins + column];
+}
+
+uint32_t
+GlobalRoutingHelper::GetPathCost(Ptr<Node> node, Ptr<Node> origin)
+{
+  return GetPathCost(node->GetId(), origin->GetId());
+}
+
+uint32_t
+GlobalRoutingHelper::GetDiameter()
+{
+  return g_pathCosts.diameter;
+}
+
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
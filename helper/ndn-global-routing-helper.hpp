@@ -100,6 +100,30 @@ public:
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Calculate routes, reusing routes saved by a previous run when possible
+   *
+   * If @p cacheFile contains routes computed for the same routing input (see
+   * GetRoutingFingerprint()), FIB next hops and path costs are installed directly from the
+   * file, bypassing both the shortest path computation and FIB management commands.
+   * Otherwise, routes are calculated by CalculateRoutes() and saved to @p cacheFile.
+   *
+   * @param cacheFile name of the route cache file
+   * @return true if routes have been installed from @p cacheFile, false if they have been
+   *         calculated
+   */
+  static bool
+  CalculateRoutes(const std::string& cacheFile);
+
+  /**
+   * @brief Get hash of everything route calculation depends on
+   *
+   * The hash covers nodes, their faces (IDs and metrics) with adjacent nodes, and origin
+   * prefixes, but not content store, SIT, or application parameters.
+   */
+  static uint64_t
+  GetRoutingFingerprint();
+
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
@@ -111,6 +135,41 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Value returned by GetPathCost when origin is not reachable from the node
+   */
+  static const uint32_t UNREACHABLE = 0xFFFFFFFF;
+
+  /**
+   * @brief Get cost of the shortest path from the node to the origin node
+   *
+   * Costs are recorded by the last CalculateRoutes() call for every node and every node that
+   * has at least one origin prefix (the same costs that are installed into FIBs), so the call
+   * does not involve any FIB lookups.
+   *
+   * @param nodeId ID of the node
+   * @param originNodeId ID of the node that originates prefixes
+   * @returns path cost (0 if the node is the origin) or UNREACHABLE
+   */
+  static uint32_t
+  GetPathCost(uint32_t nodeId, uint32_t originNodeId);
+
+  /**
+   * @brief Get cost of the shortest path from the node to the origin node
+   * @sa GetPathCost(uint32_t, uint32_t)
+   */
+  static uint32_t
+  GetPathCost(Ptr<Node> node, Ptr<Node> origin);
+
+  /**
+   * @brief Get the largest finite path cost between any node and any origin node
+   *
+   * When every node is an origin (e.g., each node is a producer for its own prefix), this is
+   * the diameter of the graph.  Value is recorded by the last CalculateRoutes() call.
+   */
+  static uint32_t
+  GetDiameter();
+
 private:
   void
   Install(Ptr<Channel> channel);
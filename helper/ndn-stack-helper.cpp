@@ -125,6 +125,12 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setFibNumericRoot(const std::string& root)
+{
+  m_fibNumericRoot = root;
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -172,6 +178,10 @@ StackHelper::Install(Ptr<Node> node) const
 
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
 
+  if (!m_fibNumericRoot.empty()) {
+    ndn->getConfig().put("ndnSIM.fib_numeric_root", m_fibNumericRoot);
+  }
+
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
     ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
@@ -75,6 +75,18 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Store FIB entries for prefixes of the form root/<number> in a direct-indexed array
+   *
+   * Longest prefix match for names under such prefixes becomes a single array access, and
+   * prefixes with identical nexthops share one FIB entry.  Useful when every producer announces
+   * a prefix built with Name::appendNumber (e.g., /prefix/0, /prefix/1, ...).
+   *
+   * @param root common prefix of the numeric producer prefixes
+   */
+  void
+  setFibNumericRoot(const std::string& root);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -261,6 +273,7 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  std::string m_fibNumericRoot;
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
@@ -22,6 +22,8 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include "ns3/ndnSIM/NFD/daemon/table/memory-usage.hpp"
+
 NS_LOG_COMPONENT_DEFINE("ndn.cs.ContentStore");
 
 namespace ns3 {
@@ -48,18 +50,42 @@ ContentStore::GetTypeId(void)
   return tid;
 }
 
+ContentStore::ContentStore()
+  : m_memoryUsage(0)
+{
+}
+
 ContentStore::~ContentStore()
 {
 }
 
+uint64_t
+ContentStore::GetMemoryUsage() const
+{
+  return m_memoryUsage;
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
 
+// entry, its trie node and policy hooks (approximated by container node overheads), and Data
+static inline uint64_t
+EstimateEntrySize(const Data& data)
+{
+  return sizeof(Entry) + 4 * nfd::memory_usage::NODE_OVERHEAD + nfd::memory_usage::estimate(data);
+}
+
 Entry::Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data)
   : m_cs(cs)
   , m_data(data)
 {
+  m_cs->m_memoryUsage += EstimateEntrySize(*m_data);
+}
+
+Entry::~Entry()
+{
+  m_cs->m_memoryUsage -= EstimateEntrySize(*m_data);
 }
 
 const Name&
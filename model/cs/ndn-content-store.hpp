@@ -64,6 +64,11 @@ public:
    */
   Entry(Ptr<ContentStore> cs, shared_ptr<const Data> data);
 
+  /**
+   * \brief Destructor, releases the memory accounted to the content store
+   */
+  ~Entry();
+
   /**
    * \brief Get prefix of the stored entry
    * \returns prefix of the stored entry
@@ -107,6 +112,8 @@ public:
   static TypeId
   GetTypeId();
 
+  ContentStore();
+
   /**
    * @brief Virtual destructor
    */
@@ -153,6 +160,14 @@ public:
   virtual uint32_t
   GetSize() const = 0;
 
+  /**
+   * @brief Get approximate number of bytes taken by content store entries and their Data
+   *
+   * The value is updated whenever an entry is created or destroyed.
+   */
+  uint64_t
+  GetMemoryUsage() const;
+
   /**
    * @brief Return first element of content store (no order guaranteed)
    */
@@ -189,6 +204,10 @@ protected:
                  shared_ptr<const Data>> m_cacheHitsTrace; ///< @brief trace of cache hits
 
   TracedCallback<shared_ptr<const Interest>> m_cacheMissesTrace; ///< @brief trace of cache misses
+
+private:
+  friend class cs::Entry;
+  uint64_t m_memoryUsage;
 };
 
 inline std::ostream&
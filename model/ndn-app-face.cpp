@@ -32,6 +32,10 @@ NS_LOG_COMPONENT_DEFINE("ndn.AppFace");
 namespace ns3 {
 namespace ndn {
 
+std::deque<AppFace::Delivery> AppFace::s_deliveryQueue;
+bool AppFace::s_isDeliveryScheduled = false;
+bool AppFace::s_isClearScheduled = false;
+
 AppFace::AppFace(Ptr<App> app)
   : LocalFace(FaceUri("appFace://"), FaceUri("appFace://"))
   , m_node(app->GetNode())
@@ -61,7 +65,7 @@ AppFace::sendInterest(const Interest& interest)
   this->emitSignal(onSendInterest, interest);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  enqueue(interest.shared_from_this(), nullptr);
 }
 
 void
@@ -72,7 +76,57 @@ AppFace::sendData(const Data& data)
   this->emitSignal(onSendData, data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  enqueue(nullptr, data.shared_from_this());
+}
+
+void
+AppFace::enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data)
+{
+  // the queue does not keep the face alive: packets of a destroyed face are dropped
+  s_deliveryQueue.push_back(Delivery{std::static_pointer_cast<AppFace>(shared_from_this()),
+                                     std::move(interest), std::move(data)});
+
+  if (!s_isClearScheduled) {
+    s_isClearScheduled = true;
+    Simulator::ScheduleDestroy(&AppFace::clearDeliveryQueue);
+  }
+
+  if (s_isDeliveryScheduled)
+    return;
+
+  s_isDeliveryScheduled = true;
+  Simulator::ScheduleNow(&AppFace::deliver);
+}
+
+void
+AppFace::deliver()
+{
+  s_isDeliveryScheduled = false;
+
+  // packets queued by applications during delivery are left for the next event, as they
+  // would be with a separate event per packet
+  for (size_t nPackets = s_deliveryQueue.size(); nPackets > 0; nPackets--) {
+    Delivery delivery = std::move(s_deliveryQueue.front());
+    s_deliveryQueue.pop_front();
+
+    // the application may release the face while processing a packet
+    shared_ptr<AppFace> face = delivery.face.lock();
+    if (face == nullptr)
+      continue;
+
+    if (delivery.interest != nullptr)
+      face->m_app->OnInterest(delivery.interest);
+    else
+      face->m_app->OnData(delivery.data);
+  }
+}
+
+void
+AppFace::clearDeliveryQueue()
+{
+  s_deliveryQueue.clear();
+  s_isDeliveryScheduled = false;
+  s_isClearScheduled = false;
 }
 
 void
@@ -24,6 +24,8 @@
 #include "ns3/ndnSIM/NFD/daemon/face/local-face.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include <deque>
+
 namespace ns3 {
 
 class Packet;
@@ -41,6 +43,16 @@ class App;
  * component responsible for actual delivery of data packet to and
  * from Ndn stack
  *
+ * Packets sent towards the application are not delivered synchronously, but queued and handed
+ * to the application from a separate simulator event.  A single pending event, shared by all
+ * AppFaces of the simulation, serves all packets queued at the current time in the order they
+ * were sent, regardless of the face they were sent on.  Packets queued while applications
+ * process delivered ones are handed over by the next event.
+ *
+ * A packet that joins a pending event is delivered before events of other kinds scheduled for
+ * the same time after that event (e.g., packets received by net devices), while with a separate
+ * event per packet it would be delivered after them.
+ *
  * \see AppFace, NdnNetDeviceFace
  */
 class AppFace : public nfd::LocalFace {
@@ -80,9 +92,40 @@ public: // from nfd::Face
   virtual void
   close();
 
+private:
+  /**
+   * @brief Queue packet for delivery to the application and schedule the delivery event
+   */
+  void
+  enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data);
+
+  /**
+   * @brief Deliver packets of all faces that have been queued before the delivery event fired
+   */
+  static void
+  deliver();
+
+  /**
+   * @brief Drop queued packets when the simulator is destroyed
+   */
+  static void
+  clearDeliveryQueue();
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+
+  /// @cond include_hidden
+  struct Delivery {
+    std::weak_ptr<AppFace> face;
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+  };
+  /// @endcond
+
+  static std::deque<Delivery> s_deliveryQueue;
+  static bool s_isDeliveryScheduled;
+  static bool s_isClearScheduled;
 };
 
 } // namespace ndn
@@ -19,11 +19,7 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
+#include <ndn-cxx/encoding/tlv.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -87,41 +83,60 @@ PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV VAR-NUMBER from the buffer iterator
+ * @throw ::ndn::tlv::Error if the buffer ends before the number is complete
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
+  }
+
+  uint8_t firstOctet = i.ReadU8();
+  if (firstOctet < 253) {
+    return firstOctet;
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint32_t size = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  if (i.GetRemainingSize() < size) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  switch (size) {
+  case 2:
+    return i.ReadNtohU16();
+  case 4:
+    return i.ReadNtohU32();
+  default:
+    return i.ReadNtohU64();
+  }
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // peek at TLV type and length, then copy the whole element with a single bulk read and decode
+  // it in place (the decoded packet keeps referencing the same buffer)
+  ns3::Buffer::Iterator peek = start;
+  readVarNumber(peek); // type
+  uint64_t length = readVarNumber(peek);
+  uint64_t headerSize = peek.GetDistanceFrom(start);
+
+  if (length > start.GetRemainingSize() - headerSize) {
+    throw ::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV");
+  }
+
+  uint32_t totalSize = static_cast<uint32_t>(headerSize + length);
+  auto buffer = make_shared<::ndn::Buffer>(totalSize);
+  start.Read(buffer->buf(), totalSize);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(::ndn::Block(buffer));
   m_packet = packet;
-  return packet->wireEncode().size();
+  return totalSize;
 }
 
 template<>
@@ -185,6 +185,11 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
+  std::string fibNumericRoot = this->getConfig().get<std::string>("ndnSIM.fib_numeric_root", "");
+  if (!fibNumericRoot.empty()) {
+    m_impl->m_forwarder->getFib().setNumericRoot(Name(fibNumericRoot));
+  }
+
   initializeManagement();
 
   if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
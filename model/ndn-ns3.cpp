@@ -25,19 +25,150 @@
 
 #include "ndn-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
+#include "../utils/ndn-wire-tag.hpp"
+#include "../utils/ndn-fw-hop-count-tag.hpp"
+
+#include "ns3/simulator.h"
+
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Bounded cache of recently serialized packets, indexed by WireTag identifiers
+ *
+ * The cache is direct-mapped: identifier i occupies slot i % SIZE until it is overwritten by
+ * identifier i + SIZE.  Packets that stay in flight longer are decoded from their bytes, as are
+ * packets tagged by another process: tags of other processes carry a different token and are
+ * not looked up.  The cache is emptied on Simulator::Destroy.
+ */
+template<class T>
+class WireCache {
+public:
+  static WireCache&
+  get()
+  {
+    static WireCache cache;
+    return cache;
+  }
+
+  WireTag
+  insert(shared_ptr<const T> pkt)
+  {
+    if (!m_isDestroyScheduled) {
+      Simulator::ScheduleDestroy(&WireCache::clear, this);
+      m_isDestroyScheduled = true;
+    }
+
+    uint64_t id = ++m_lastId;
+    Entry& entry = m_entries[id % SIZE];
+    entry.id = id;
+    entry.packet = std::move(pkt);
+    return WireTag(WireTag::GetCurrentProcess(), id);
+  }
+
+  shared_ptr<const T>
+  find(const WireTag& tag) const
+  {
+    if (tag.GetProcess() != WireTag::GetCurrentProcess()) {
+      return nullptr;
+    }
+
+    const Entry& entry = m_entries[tag.Get() % SIZE];
+    if (entry.id != tag.Get()) {
+      return nullptr;
+    }
+    return entry.packet;
+  }
+
+private:
+  WireCache()
+    : m_entries(SIZE)
+    , m_lastId(0)
+    , m_isDestroyScheduled(false)
+  {
+  }
+
+  void
+  clear()
+  {
+    m_entries.assign(SIZE, Entry());
+    m_isDestroyScheduled = false;
+  }
+
+private:
+  static const size_t SIZE = 4096;
+
+  struct Entry {
+    Entry()
+      : id(0)
+    {
+    }
+
+    uint64_t id;
+    shared_ptr<const T> packet;
+  };
+
+  std::vector<Entry> m_entries;
+  uint64_t m_lastId;
+  bool m_isDestroyScheduled;
+};
+
+/**
+ * @brief Cache an immutable snapshot of @p data for the receivers of @p packet
+ *
+ * Data is never modified in place, so a copy that shares the wire buffer is a snapshot that
+ * does not change when the sender modifies its own Data.  Tags and LocalControlHeader belong
+ * to the sender and are not passed to the receivers.
+ */
+static void
+addWireTag(Ptr<Packet> packet, const Data& data)
+{
+  shared_ptr<Data> snapshot = make_shared<Data>(data);
+  static_cast< ::ndn::TagHost&>(*snapshot) = ::ndn::TagHost();
+  snapshot->getLocalControlHeader() = ::ndn::nfd::LocalControlHeader();
+
+  packet->AddPacketTag(WireCache<Data>::get().insert(snapshot));
+}
+
+/**
+ * Interests are not shared: the forwarder rewrites Nonce, FloodFlag, and DestinationFlag of an
+ * Interest in place in its wire (Interest::setNonce and others), separately for every outgoing
+ * face, so each receiver decodes its own copy of the bytes.
+ */
+static void
+addWireTag(Ptr<Packet> packet, const Interest&)
+{
+}
+
 template<class T>
 std::shared_ptr<const T>
 Convert::FromPacket(Ptr<Packet> packet)
 {
-  PacketHeader<T> header;
-  packet->RemoveHeader(header);
+  shared_ptr<const T> pkt;
+
+  // the packet was serialized in this process and its snapshot is still cached: copy the
+  // snapshot, which shares the wire buffer, and skip the bytes it was serialized to
+  WireTag wireTag;
+  if (packet->RemovePacketTag(wireTag)) {
+    shared_ptr<const T> snapshot = WireCache<T>::get().find(wireTag);
+    if (snapshot != nullptr && snapshot->wireEncode().size() == packet->GetSize()) {
+      packet->RemoveAtStart(snapshot->wireEncode().size());
+      pkt = make_shared<T>(*snapshot);
+    }
+  }
+
+  if (pkt == nullptr) {
+    PacketHeader<T> header;
+    packet->RemoveHeader(header);
+    pkt = header.getPacket();
+  }
 
-  auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  // keep only the hop count, the ns-3 packet itself is released when the caller drops it
+  FwHopCountTag hopCountTag;
+  packet->PeekPacketTag(hopCountTag);
+  pkt->setTag(make_shared<Ns3PacketTag>(hopCountTag.Get()));
 
   return pkt;
 }
@@ -54,17 +185,15 @@ Convert::ToPacket(const T& pkt)
 {
   PacketHeader<T> header(pkt);
 
-  Ptr<Packet> packet;
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(header);
 
   auto tag = pkt.template getTag<Ns3PacketTag>();
   if (tag != nullptr) {
-    packet = tag->getPacket()->Copy();
-  }
-  else {
-    packet = Create<Packet>();
+    packet->AddPacketTag(FwHopCountTag(tag->getHopCount()));
   }
+  addWireTag(packet, pkt);
 
-  packet->AddHeader(header);
   return packet;
 }
 
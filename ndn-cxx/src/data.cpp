@@ -21,6 +21,7 @@
 
 #include "data.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/element-index.hpp"
 #include "util/crypto.hpp"
 
 namespace ndn {
@@ -121,13 +122,29 @@ Data::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  if (!m_signature)
+    {
+      BOOST_THROW_EXCEPTION(Error("Requested wire format, but data packet has not been signed yet"));
+    }
 
-  EncodingBuffer buffer(estimatedSize, 0);
+  // the size is computed from the sizes of already encoded elements, so the Data is encoded in
+  // a single pass into a buffer of the exact size
+  size_t valueLength = m_signature.getValue().size();
+  valueLength += m_signature.getInfo().size();
+  valueLength += getContent().size();
+  valueLength += getMetaInfo().wireEncode().size(); // cached, prepended as is
+  valueLength += getName().wireSize();
+
+  size_t totalLength = encoding::sizeOfBlock(tlv::Data, valueLength);
+  EncodingBuffer buffer(totalLength, 0);
   wireEncode(buffer);
+  BOOST_ASSERT(buffer.size() == totalLength);
+
+  // Content is re-pointed into the new wire, so the payload is not held twice.  Other fields
+  // keep their blocks, the wire does not need to be decoded again.
+  m_wire = buffer.block();
+  m_content = encoding::ElementIndex(m_wire).get(tlv::Content);
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
   return m_wire;
 }
 
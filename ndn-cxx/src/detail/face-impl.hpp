@@ -27,6 +27,8 @@
 
 #include "registered-prefix.hpp"
 #include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "interest-filter-table.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
@@ -52,8 +54,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   class NfdFace : public ::nfd::LocalFace
@@ -131,26 +131,17 @@ public:
   void
   satisfyPendingInterests(const Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest().matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-
-        entry = m_pendingInterestTable.erase(entry);
-
-        matchedEntry->invokeDataCallback(data);
-      }
-      else
-        ++entry;
+    // matching entries are removed from the table before any callback is invoked
+    for (const auto& matchedEntry : m_pendingInterestTable.extractDataMatches(data)) {
+      matchedEntry->invokeDataCallback(data);
     }
   }
 
   void
   processInterestFilters(const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -164,8 +155,8 @@ public:
     auto entry =
       m_pendingInterestTable.insert(make_shared<PendingInterest>(interest,
                                                                  onData, onTimeout,
-                                                                 ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+                                                                 ref(m_scheduler)));
+    entry->pendingInterest->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
 
     m_nfdFace->emitSignal(onReceiveInterest, *interest);
   }
@@ -173,7 +164,7 @@ public:
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.remove(pendingInterestId);
   }
 
   void
@@ -194,13 +185,7 @@ public:
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "interest-filter-record.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interest filters of a Face, organized as a trie of filter prefixes
+ *
+ * An Interest is dispatched by walking the trie along the Interest name, so only filters
+ * whose prefix is a prefix of the Interest name are checked (InterestFilterRecord::doesMatch
+ * still evaluates the regex filter, if any).  Matching filters are returned in the order
+ * they were added to the table.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  InterestFilterTable()
+    : m_lastSeqNo(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  void
+  push_back(const shared_ptr<InterestFilterRecord>& record)
+  {
+    const Name& prefix = record->getFilter().getPrefix();
+
+    Node* node = &m_root;
+    for (const name::Component& component : prefix) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+
+    node->records.push_back(std::make_pair(++m_lastSeqNo, record));
+    m_records[record.get()] = record;
+  }
+
+  /**
+   * @brief Remove the filter with the given id (address of the record)
+   */
+  void
+  erase(const InterestFilterId* interestFilterId)
+  {
+    auto i = m_records.find(reinterpret_cast<const InterestFilterRecord*>(interestFilterId));
+    if (i != m_records.end()) {
+      remove(i->second);
+    }
+  }
+
+  void
+  remove(shared_ptr<InterestFilterRecord> record)
+  {
+    if (m_records.erase(record.get()) == 0) {
+      return;
+    }
+    removeFromNode(m_root, record->getFilter().getPrefix(), 0, record.get());
+  }
+
+  /**
+   * @brief Find filters that match the Interest name
+   * @return matching filters, in the order they were added
+   */
+  std::vector<shared_ptr<InterestFilterRecord>>
+  findMatches(const Name& name) const
+  {
+    std::vector<std::pair<uint64_t, shared_ptr<InterestFilterRecord>>> matches;
+
+    const Node* node = &m_root;
+    for (size_t depth = 0; ; ++depth) {
+      for (const auto& record : node->records) {
+        if (record.second->doesMatch(name)) {
+          matches.push_back(record);
+        }
+      }
+
+      if (depth == name.size()) {
+        break;
+      }
+      auto child = node->children.find(name.get(depth));
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const std::pair<uint64_t, shared_ptr<InterestFilterRecord>>& a,
+                  const std::pair<uint64_t, shared_ptr<InterestFilterRecord>>& b) {
+                return a.first < b.first;
+              });
+
+    std::vector<shared_ptr<InterestFilterRecord>> records;
+    records.reserve(matches.size());
+    for (const auto& match : matches) {
+      records.push_back(match.second);
+    }
+    return records;
+  }
+
+private:
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<std::pair<uint64_t, shared_ptr<InterestFilterRecord>>> records;
+  };
+
+  /**
+   * @brief Remove the record from the node of the prefix and prune emptied nodes
+   * @return true if the node became empty
+   */
+  static bool
+  removeFromNode(Node& node, const Name& prefix, size_t depth, const InterestFilterRecord* record)
+  {
+    if (depth == prefix.size()) {
+      for (auto i = node.records.begin(); i != node.records.end(); ++i) {
+        if (i->second.get() == record) {
+          node.records.erase(i);
+          break;
+        }
+      }
+    }
+    else {
+      auto child = node.children.find(prefix.get(depth));
+      if (child != node.children.end() &&
+          removeFromNode(*child->second, prefix, depth + 1, record)) {
+        node.children.erase(child);
+      }
+    }
+    return node.records.empty() && node.children.empty();
+  }
+
+private:
+  Node m_root;
+  std::unordered_map<const InterestFilterRecord*, shared_ptr<InterestFilterRecord>> m_records;
+  uint64_t m_lastSeqNo;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
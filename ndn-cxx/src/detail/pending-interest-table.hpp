@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../util/signal.hpp"
+#include "pending-interest.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of pending Interests of a Face, indexed by the hash of the Interest name
+ *
+ * A Data packet can satisfy Interests whose name is a prefix of the Data name, or is the full
+ * name of the Data (implicit digest).  Instead of checking every pending Interest, the table
+ * keeps the number of pending Interests for every name length and probes the index only with
+ * the prefixes of the Data name of these lengths.  Candidates found in the index are verified
+ * with Interest::matchesData, which also evaluates the selectors.  The full name, which
+ * requires computing the digest, is probed only if there are Interests as long as the full
+ * name.
+ *
+ * Entries are kept in the insertion order, and matching entries are returned in this order.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  struct Entry
+  {
+    shared_ptr<PendingInterest> pendingInterest;
+    uint64_t seqNo;
+    size_t nameHash;
+  };
+
+  typedef std::list<Entry> EntryList;
+  typedef EntryList::iterator iterator;
+
+  PendingInterestTable()
+    : m_lastSeqNo(0)
+  {
+  }
+
+  iterator
+  begin()
+  {
+    return m_entries.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_entries.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_entries.empty();
+  }
+
+  /**
+   * @brief Add pending Interest to the table
+   * @return iterator that stays valid until the entry is erased
+   */
+  iterator
+  insert(const shared_ptr<PendingInterest>& pendingInterest)
+  {
+    const Name& name = pendingInterest->getInterest().getName();
+
+    Entry entry;
+    entry.pendingInterest = pendingInterest;
+    entry.seqNo = ++m_lastSeqNo;
+    entry.nameHash = computeHash(name, name.size());
+
+    iterator i = m_entries.insert(m_entries.end(), entry);
+    m_index.insert(std::make_pair(entry.nameHash, i));
+    m_byInterest[&pendingInterest->getInterest()] = i;
+
+    if (m_nNamesOfLength.size() <= name.size()) {
+      m_nNamesOfLength.resize(name.size() + 1, 0);
+    }
+    m_nNamesOfLength[name.size()]++;
+
+    return i;
+  }
+
+  iterator
+  erase(iterator i)
+  {
+    const Interest& interest = i->pendingInterest->getInterest();
+
+    auto range = m_index.equal_range(i->nameHash);
+    for (auto j = range.first; j != range.second; ++j) {
+      if (j->second == i) {
+        m_index.erase(j);
+        break;
+      }
+    }
+    m_byInterest.erase(&interest);
+    m_nNamesOfLength[interest.getName().size()]--;
+
+    iterator next = m_entries.erase(i);
+    if (empty()) {
+      this->onEmpty();
+    }
+    return next;
+  }
+
+  /**
+   * @brief Remove pending Interest with the given id (address of the Interest)
+   */
+  void
+  remove(const PendingInterestId* pendingInterestId)
+  {
+    auto i = m_byInterest.find(reinterpret_cast<const Interest*>(pendingInterestId));
+    if (i != m_byInterest.end()) {
+      erase(i->second);
+    }
+  }
+
+  void
+  clear()
+  {
+    m_entries.clear();
+    m_index.clear();
+    m_byInterest.clear();
+    m_nNamesOfLength.clear();
+    this->onEmpty();
+  }
+
+  /**
+   * @brief Remove all pending Interests satisfied by the Data
+   * @return removed pending Interests, in the order they were inserted
+   */
+  std::vector<shared_ptr<PendingInterest>>
+  extractDataMatches(const Data& data)
+  {
+    std::vector<iterator> matches;
+    const Name& dataName = data.getName();
+
+    size_t hash = HASH_SEED;
+    for (size_t length = 0; length <= dataName.size(); ++length) {
+      if (length > 0) {
+        boost::hash_combine(hash, computeHash(dataName.get(length - 1)));
+      }
+      if (length < m_nNamesOfLength.size() && m_nNamesOfLength[length] > 0) {
+        findMatches(hash, data, matches);
+      }
+    }
+
+    size_t fullNameLength = dataName.size() + 1;
+    if (fullNameLength < m_nNamesOfLength.size() && m_nNamesOfLength[fullNameLength] > 0) {
+      const Name& fullName = data.getFullName();
+      boost::hash_combine(hash, computeHash(fullName.get(-1)));
+      findMatches(hash, data, matches);
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (iterator a, iterator b) { return a->seqNo < b->seqNo; });
+
+    std::vector<shared_ptr<PendingInterest>> pendingInterests;
+    pendingInterests.reserve(matches.size());
+    for (iterator i : matches) {
+      pendingInterests.push_back(i->pendingInterest);
+      erase(i);
+    }
+    return pendingInterests;
+  }
+
+  /**
+   * @brief Compute hash of the first @p length components of the name
+   */
+  static size_t
+  computeHash(const Name& name, size_t length)
+  {
+    size_t hash = HASH_SEED;
+    for (size_t i = 0; i < length; ++i) {
+      boost::hash_combine(hash, computeHash(name.get(i)));
+    }
+    return hash;
+  }
+
+private:
+  static size_t
+  computeHash(const name::Component& component)
+  {
+    size_t hash = component.type();
+    boost::hash_range(hash, component.value(), component.value() + component.value_size());
+    return hash;
+  }
+
+  void
+  findMatches(size_t hash, const Data& data, std::vector<iterator>& matches) const
+  {
+    auto range = m_index.equal_range(hash);
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second->pendingInterest->getInterest().matchesData(data)) {
+        matches.push_back(i->second);
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when the table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  static const size_t HASH_SEED = 0;
+
+  EntryList m_entries;
+  std::unordered_multimap<size_t, iterator> m_index;
+  std::unordered_map<const Interest*, iterator> m_byInterest;
+  std::vector<size_t> m_nNamesOfLength; ///< number of pending Interests for each name length
+  uint64_t m_lastSeqNo;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -21,9 +21,17 @@
 
 #include "block-helpers.hpp"
 
+#include <limits>
+
 namespace ndn {
 namespace encoding {
 
+size_t
+sizeOfBlock(uint32_t type, size_t valueLength)
+{
+  return tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength) + valueLength;
+}
+
 template<Tag TAG>
 size_t
 prependNonNegativeIntegerBlock(EncodingImpl<TAG>& encoder, uint32_t type, uint64_t value)
@@ -57,6 +65,24 @@ makeNonNegativeIntegerBlock(uint32_t type, uint64_t value)
   return encoder.block();
 }
 
+size_t
+sizeOfNonNegativeIntegerBlock(uint32_t type, uint64_t value)
+{
+  // widths used by Encoder::prependNonNegativeInteger (tlv::sizeOfNonNegativeInteger follows
+  // the VAR-NUMBER rules and gives 2 octets for 253-255)
+  size_t valueLength = 8;
+  if (value <= std::numeric_limits<uint8_t>::max()) {
+    valueLength = 1;
+  }
+  else if (value <= std::numeric_limits<uint16_t>::max()) {
+    valueLength = 2;
+  }
+  else if (value <= std::numeric_limits<uint32_t>::max()) {
+    valueLength = 4;
+  }
+  return sizeOfBlock(type, valueLength);
+}
+
 uint64_t
 readNonNegativeInteger(const Block& block)
 {
@@ -31,6 +31,12 @@
 namespace ndn {
 namespace encoding {
 
+/**
+ * @brief Get the size of TLV block type @p type with value of @p valueLength octets
+ */
+size_t
+sizeOfBlock(uint32_t type, size_t valueLength);
+
 /**
  * @brief Helper to prepend TLV block type @p type containing non-negative integer @p value
  * @see makeNonNegativeIntegerBlock, readNonNegativeInteger
@@ -46,6 +52,13 @@ prependNonNegativeIntegerBlock(EncodingImpl<TAG>& encoder, uint32_t type, uint64
 Block
 makeNonNegativeIntegerBlock(uint32_t type, uint64_t value);
 
+/**
+ * @brief Get the size of TLV block type @p type containing non-negative integer @p value
+ * @see prependNonNegativeIntegerBlock
+ */
+size_t
+sizeOfNonNegativeIntegerBlock(uint32_t type, uint64_t value);
+
 /**
  * @brief Helper to read a non-negative integer from a block
  * @see prependNonNegativeIntegerBlock, makeNonNegativeIntegerBlock
@@ -327,6 +327,18 @@ Block::parse() const
   Buffer::const_iterator begin = value_begin();
   Buffer::const_iterator end = value_end();
 
+  // count elements first, so that all subblocks are stored in a single allocation
+  size_t nElements = 0;
+  for (Buffer::const_iterator i = begin; i != end; ++nElements)
+    {
+      tlv::readType(i, end);
+      uint64_t length = tlv::readVarNumber(i, end);
+      if (length > static_cast<uint64_t>(end - i))
+        BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+      i += length;
+    }
+  m_subBlocks.reserve(nElements);
+
   while (begin != end)
     {
       Buffer::const_iterator element_begin = begin;
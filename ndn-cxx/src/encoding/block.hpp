@@ -241,6 +241,8 @@ public: // sub elements
    *
    *  This method is not really const, but it does not modify any data.  It simply
    *  parses contents of the buffer into subblocks
+   *
+   *  @sa encoding::ElementIndex to locate sub elements without creating subblocks
    */
   void
   parse() const;
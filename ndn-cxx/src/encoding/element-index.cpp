@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "element-index.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+namespace encoding {
+
+const size_t ElementIndex::INLINE_CAPACITY;
+
+ElementIndex::ElementIndex(const Block& block)
+  : m_block(block)
+  , m_size(0)
+{
+  if (block.value_size() == 0)
+    return;
+
+  Buffer::const_iterator begin = block.value_begin();
+  Buffer::const_iterator end = block.value_end();
+
+  while (begin != end) {
+    Entry entry;
+    entry.begin = begin;
+    entry.type = tlv::readType(begin, end);
+    uint64_t length = tlv::readVarNumber(begin, end);
+
+    if (length > static_cast<uint64_t>(end - begin)) {
+      BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+    }
+    entry.valueBegin = begin;
+    entry.end = begin + length;
+
+    if (m_size < INLINE_CAPACITY)
+      m_inline[m_size] = entry;
+    else
+      m_overflow.push_back(entry);
+    ++m_size;
+
+    begin = entry.end;
+  }
+}
+
+const ElementIndex::Entry*
+ElementIndex::find(uint32_t type) const
+{
+  for (size_t i = 0; i < m_size; ++i) {
+    const Entry& entry = (*this)[i];
+    if (entry.type == type)
+      return &entry;
+  }
+  return nullptr;
+}
+
+Block
+ElementIndex::makeBlock(const Entry& entry) const
+{
+  return Block(m_block.getBuffer(), entry.type, entry.begin, entry.end,
+               entry.valueBegin, entry.end);
+}
+
+Block
+ElementIndex::get(uint32_t type) const
+{
+  const Entry* entry = find(type);
+  if (entry == nullptr) {
+    BOOST_THROW_EXCEPTION(Block::Error("(ElementIndex::get) Requested a non-existed type [" +
+                                       boost::lexical_cast<std::string>(type) + "] from Block"));
+  }
+  return makeBlock(*entry);
+}
+
+uint64_t
+ElementIndex::readNonNegativeInteger(uint32_t type) const
+{
+  const Entry* entry = find(type);
+  if (entry == nullptr) {
+    BOOST_THROW_EXCEPTION(Block::Error("(ElementIndex::readNonNegativeInteger) Requested a "
+                                       "non-existed type [" +
+                                       boost::lexical_cast<std::string>(type) + "] from Block"));
+  }
+  return readNonNegativeInteger(*entry);
+}
+
+uint64_t
+ElementIndex::readNonNegativeInteger(const Entry& entry)
+{
+  Buffer::const_iterator begin = entry.valueBegin;
+  return tlv::readNonNegativeInteger(entry.end - entry.valueBegin, begin, entry.end);
+}
+
+} // namespace encoding
+} // namespace ndn
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_ELEMENT_INDEX_HPP
+#define NDN_ENCODING_ELEMENT_INDEX_HPP
+
+#include "../common.hpp"
+#include "block.hpp"
+
+namespace ndn {
+namespace encoding {
+
+/**
+ * @brief Lightweight index of sub elements of a Block
+ *
+ * Unlike Block::parse, which creates a Block (holding a copy of the buffer reference) for each
+ * sub element, the index only records type and offsets of the sub elements.  The first
+ * INLINE_CAPACITY entries are stored inside the index object itself, so indexing a typical
+ * packet does not allocate.  Blocks for sub elements are created only when requested.
+ *
+ * The index refers to the indexed block, which must outlive the index and must not be
+ * modified while the index is in use.
+ */
+class ElementIndex : noncopyable
+{
+public:
+  struct Entry
+  {
+    uint32_t type;
+    Buffer::const_iterator begin;
+    Buffer::const_iterator valueBegin;
+    Buffer::const_iterator end;
+  };
+
+  static const size_t INLINE_CAPACITY = 8;
+
+  /**
+   * @brief Index top-level sub elements of @p block
+   * @throw tlv::Error sub elements are malformed (same conditions as Block::parse)
+   */
+  explicit
+  ElementIndex(const Block& block);
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  const Entry&
+  operator[](size_t i) const
+  {
+    return i < INLINE_CAPACITY ? m_inline[i] : m_overflow[i - INLINE_CAPACITY];
+  }
+
+  /**
+   * @return the first entry of the requested type, or nullptr if there is none
+   */
+  const Entry*
+  find(uint32_t type) const;
+
+  /**
+   * @return true if there is a sub element of the requested type
+   */
+  bool
+  has(uint32_t type) const
+  {
+    return find(type) != nullptr;
+  }
+
+  /**
+   * @brief Create Block of the entry, the Block shares buffer of the indexed block
+   */
+  Block
+  makeBlock(const Entry& entry) const;
+
+  /**
+   * @brief Create Block of the first sub element of the requested type
+   * @throw Block::Error there is no sub element of the requested type
+   */
+  Block
+  get(uint32_t type) const;
+
+  /**
+   * @brief Read nonNegativeInteger value of the first sub element of the requested type,
+   *        without creating a Block
+   * @throw Block::Error there is no sub element of the requested type
+   * @throw tlv::Error the value is not a valid nonNegativeInteger
+   */
+  uint64_t
+  readNonNegativeInteger(uint32_t type) const;
+
+  /**
+   * @brief Read nonNegativeInteger value of the entry, without creating a Block
+   * @throw tlv::Error the value is not a valid nonNegativeInteger
+   */
+  static uint64_t
+  readNonNegativeInteger(const Entry& entry);
+
+private:
+  const Block& m_block;
+  size_t m_size;
+  Entry m_inline[INLINE_CAPACITY];
+  std::vector<Entry> m_overflow;
+};
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_ELEMENT_INDEX_HPP
@@ -21,11 +21,61 @@
 
 #include "encoder.hpp"
 
+#include <boost/thread/tss.hpp>
+
 namespace ndn {
 namespace encoding {
 
+static const size_t REUSABLE_BUFFER_SIZE = 8800;
+static const size_t MAX_REUSABLE_BUFFERS = 4;
+
+namespace {
+
+/**
+ * @brief Reusable encoding buffers of a thread
+ */
+class ReusableBuffers : noncopyable
+{
+public:
+  shared_ptr<Buffer>
+  acquire()
+  {
+    if (m_buffers.empty())
+      return make_shared<Buffer>(REUSABLE_BUFFER_SIZE);
+
+    shared_ptr<Buffer> buffer = std::move(m_buffers.back());
+    m_buffers.pop_back();
+    return buffer;
+  }
+
+  void
+  release(shared_ptr<Buffer>&& buffer)
+  {
+    // a few buffers are enough for nested encoders, the rest is freed
+    if (m_buffers.size() < MAX_REUSABLE_BUFFERS)
+      m_buffers.push_back(std::move(buffer));
+  }
+
+private:
+  std::vector<shared_ptr<Buffer>> m_buffers;
+};
+
+} // namespace
+
+static boost::thread_specific_ptr<ReusableBuffers> g_reusableBuffers;
+
+static ReusableBuffers&
+getReusableBuffers()
+{
+  if (g_reusableBuffers.get() == nullptr) {
+    g_reusableBuffers.reset(new ReusableBuffers());
+  }
+  return *g_reusableBuffers;
+}
+
 Encoder::Encoder(size_t totalReserve/* = 8800*/, size_t reserveFromBack/* = 400*/)
-  : m_buffer(new Buffer(totalReserve))
+  : m_buffer(make_shared<Buffer>(totalReserve))
+  , m_isReusable(false)
 {
   m_begin = m_end = m_buffer->end() - (reserveFromBack < totalReserve ? reserveFromBack : 0);
 }
@@ -33,11 +83,25 @@ Encoder::Encoder(size_t totalReserve/* = 8800*/, size_t reserveFromBack/* = 400*
 
 Encoder::Encoder(const Block& block)
   : m_buffer(const_pointer_cast<Buffer>(block.getBuffer()))
+  , m_isReusable(false)
   , m_begin(m_buffer->begin() + (block.begin() - m_buffer->begin()))
   , m_end(m_buffer->begin()   + (block.end()   - m_buffer->begin()))
 {
 }
 
+Encoder::Encoder(ReusableBufferTag, size_t reserveFromBack/* = 400*/)
+  : m_buffer(getReusableBuffers().acquire())
+  , m_isReusable(true)
+{
+  m_begin = m_end = m_buffer->end() - (reserveFromBack < m_buffer->size() ? reserveFromBack : 0);
+}
+
+Encoder::~Encoder()
+{
+  if (m_isReusable && m_buffer.unique())
+    getReusableBuffers().release(std::move(m_buffer));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -59,6 +123,11 @@ Encoder::reserveFront(size_t size)
 Block
 Encoder::block(bool verifyLength/* = true*/) const
 {
+  if (m_isReusable) {
+    shared_ptr<Buffer> buffer = make_shared<Buffer>(m_begin, m_end);
+    return Block(buffer, buffer->begin(), buffer->end(), verifyLength);
+  }
+
   return Block(m_buffer,
                m_begin, m_end,
                verifyLength);
@@ -75,10 +144,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_buffer->end() - m_end;
     size_t diffBegin = m_buffer->end() - m_begin;
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = make_shared<Buffer>(size);
     std::copy_backward(m_buffer->begin(), m_buffer->end(), buf->end());
 
-    m_buffer.reset(buf);
+    m_buffer = buf;
 
     m_end = m_buffer->end() - diffEnd;
     m_begin = m_buffer->end() - diffBegin;
@@ -87,10 +156,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_end - m_buffer->begin();
     size_t diffBegin = m_begin - m_buffer->begin();
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = make_shared<Buffer>(size);
     std::copy(m_buffer->begin(), m_buffer->end(), buf->begin());
 
-    m_buffer.reset(buf);
+    m_buffer = buf;
 
     m_end = m_buffer->begin() + diffEnd;
     m_begin = m_buffer->begin() + diffBegin;
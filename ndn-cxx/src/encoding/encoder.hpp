@@ -28,6 +28,13 @@
 namespace ndn {
 namespace encoding {
 
+/**
+ * @brief Selects the Encoder constructor that uses a reusable buffer of the calling thread
+ */
+struct ReusableBufferTag
+{
+};
+
 /**
  * @brief Helper class to perform TLV encoding
  * Interface of this class (mostly) matches interface of Estimator class
@@ -157,6 +164,21 @@ public: // unique interface to the Encoder
   explicit
   Encoder(const Block& block);
 
+  /**
+   * @brief Create instance of the encoder on a reusable buffer of the calling thread
+   *
+   * Intended for encoding when the size is not known in advance.  Instead of allocating a
+   * buffer of the default size on every use, the encoder takes a buffer from a small
+   * thread-local pool and returns it to the pool when destroyed (unless getBuffer() has been
+   * shared).  block() copies the encoded data into a buffer of the exact size, so Blocks never
+   * refer to the reusable buffer.
+   *
+   * @param reserveFromBack number of bytes to reserve for append* operations
+   */
+  Encoder(ReusableBufferTag, size_t reserveFromBack = 400);
+
+  ~Encoder();
+
   /**
    * @brief Reserve @p size bytes for the underlying buffer
    * @param addInFront if true, then @p size bytes will be available in front (i.e., subsequent call
@@ -243,12 +265,14 @@ public: // accessors
    * @param verifyLength If this parameter set to true, Block's constructor
    *                     will be requested to verify consistency of the encoded
    *                     length in the Block, otherwise ignored
+   * @note If the encoder uses a reusable buffer, the Block gets a copy of the encoded data
    */
   Block
   block(bool verifyLength = true) const;
 
 private:
   shared_ptr<Buffer> m_buffer;
+  bool m_isReusable;
 
   // invariant: m_begin always points to the position of last-written byte (if prepending data)
   iterator m_begin;
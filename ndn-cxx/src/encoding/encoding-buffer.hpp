@@ -48,6 +48,12 @@ public:
     : Encoder(block)
   {
   }
+
+  explicit
+  EncodingImpl(ReusableBufferTag tag, size_t reserveFromBack = 400)
+    : Encoder(tag, reserveFromBack)
+  {
+  }
 };
 
 /**
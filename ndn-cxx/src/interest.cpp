@@ -23,6 +23,8 @@
 #include "util/random.hpp"
 #include "util/crypto.hpp"
 #include "data.hpp"
+#include "encoding/block-helpers.hpp"
+#include "encoding/element-index.hpp"
 
 //Onur
 #include "ns3/log.h"
@@ -269,19 +271,12 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   totalLength += getName().wireEncode(encoder);
 
   // Destination Flag
-  getDestinationFlag();
- 
-  NS_LOG_INFO (">> WireEncode Destination Flag: " << m_destinationFlag.get()<<" "<<readNonNegativeInteger(m_dfBlock));
-
+  getDestinationFlag(); // to ensure that DestinationFlag is properly set
   totalLength += encoder.prependBlock(m_dfBlock);
-  //totalLength += getDestinationFlag().wireEncode(encoder);
 
- // Flood Flag
-  getFloodFlag();
-  NS_LOG_INFO (">> WireEncode Flood Flag: " << m_floodFlag.get() << " "<<readNonNegativeInteger(m_ffBlock));
-  
+  // Flood Flag
+  getFloodFlag(); // to ensure that FloodFlag is properly set
   totalLength += encoder.prependBlock(m_ffBlock);
-  
 
   totalLength += encoder.prependVarNumber(totalLength);
   totalLength += encoder.prependVarNumber(tlv::Interest);
@@ -294,20 +289,186 @@ Interest::wireEncode<encoding::EncoderTag>(EncodingImpl<encoding::EncoderTag>& e
 template size_t
 Interest::wireEncode<encoding::EstimatorTag>(EncodingImpl<encoding::EstimatorTag>& encoder) const;
 
+namespace {
+
+/** @brief Interest elements, in the order they are written by Interest::wireEncode
+ */
+enum InterestElement {
+  ELEMENT_FLOOD_FLAG,
+  ELEMENT_DESTINATION_FLAG,
+  ELEMENT_NAME,
+  ELEMENT_SELECTORS,
+  ELEMENT_NONCE,
+  ELEMENT_INTEREST_LIFETIME,
+  ELEMENT_LINK,
+  ELEMENT_SELECTED_DELEGATION,
+  N_INTEREST_ELEMENTS
+};
+
+const uint32_t INTEREST_ELEMENT_TYPES[N_INTEREST_ELEMENTS] = {
+  tlv::FloodFlag,
+  tlv::DestinationFlag,
+  tlv::Name,
+  tlv::Selectors,
+  tlv::Nonce,
+  tlv::InterestLifetime,
+  tlv::Data,
+  tlv::SelectedDelegation
+};
+
+typedef encoding::ElementIndex::Entry Element;
+
+struct InterestElements
+{
+  Element element[N_INTEREST_ELEMENTS];
+  bool has[N_INTEREST_ELEMENTS];
+};
+
+InterestElement
+getInterestElement(uint32_t type)
+{
+  switch (type) {
+  case tlv::FloodFlag:
+    return ELEMENT_FLOOD_FLAG;
+  case tlv::DestinationFlag:
+    return ELEMENT_DESTINATION_FLAG;
+  case tlv::Name:
+    return ELEMENT_NAME;
+  case tlv::Selectors:
+    return ELEMENT_SELECTORS;
+  case tlv::Nonce:
+    return ELEMENT_NONCE;
+  case tlv::InterestLifetime:
+    return ELEMENT_INTEREST_LIFETIME;
+  case tlv::Data:
+    return ELEMENT_LINK;
+  case tlv::SelectedDelegation:
+    return ELEMENT_SELECTED_DELEGATION;
+  default:
+    return N_INTEREST_ELEMENTS;
+  }
+}
+
+/** @brief Locate Interest elements in a single pass over the wire
+ *  @return false if elements are not exactly in the form produced by Interest::wireEncode
+ *          (unknown, duplicate, out of order, or missing mandatory elements)
+ */
+bool
+findElementsInWireOrder(const Block& wire, InterestElements& elements)
+{
+  std::fill(elements.has, elements.has + N_INTEREST_ELEMENTS, false);
+
+  Buffer::const_iterator begin = wire.value_begin();
+  Buffer::const_iterator end = wire.value_end();
+  int last = -1;
+
+  while (begin != end) {
+    Element element;
+    element.begin = begin;
+    element.type = tlv::readType(begin, end);
+    uint64_t length = tlv::readVarNumber(begin, end);
+    if (length > static_cast<uint64_t>(end - begin)) {
+      BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+    }
+    element.valueBegin = begin;
+    element.end = begin + length;
+    begin = element.end;
+
+    InterestElement index = getInterestElement(element.type);
+    if (index == N_INTEREST_ELEMENTS || index <= last) {
+      return false;
+    }
+    elements.element[index] = element;
+    elements.has[index] = true;
+    last = index;
+  }
+
+  return elements.has[ELEMENT_FLOOD_FLAG] && elements.has[ELEMENT_DESTINATION_FLAG] &&
+         elements.has[ELEMENT_NAME] && elements.has[ELEMENT_NONCE];
+}
+
+/** @brief Locate Interest elements in any order, ignoring unknown elements
+ *  @throw Block::Error a mandatory element is missing
+ */
+void
+findElements(const Block& wire, InterestElements& elements)
+{
+  encoding::ElementIndex index(wire);
+  for (int i = 0; i < N_INTEREST_ELEMENTS; ++i) {
+    const Element* element = index.find(INTEREST_ELEMENT_TYPES[i]);
+    elements.has[i] = element != nullptr;
+    if (elements.has[i]) {
+      elements.element[i] = *element;
+    }
+  }
+
+  static const InterestElement MANDATORY[] = {ELEMENT_FLOOD_FLAG, ELEMENT_DESTINATION_FLAG,
+                                              ELEMENT_NAME, ELEMENT_NONCE};
+  for (InterestElement i : MANDATORY) {
+    if (!elements.has[i]) {
+      BOOST_THROW_EXCEPTION(Block::Error("(Interest::wireDecode) Requested a non-existed type [" +
+                                         std::to_string(INTEREST_ELEMENT_TYPES[i]) + "] from Block"));
+    }
+  }
+}
+
+Block
+makeElementBlock(const Block& wire, const Element& element)
+{
+  return Block(wire.getBuffer(), element.type, element.begin, element.end,
+               element.valueBegin, element.end);
+}
+
+} // namespace
+
 const Block&
 Interest::wireEncode() const
 {
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  // the size is computed from the sizes of already encoded elements, so the Interest is
+  // encoded in a single pass into a buffer of the exact size
+  size_t valueLength = 0;
+  if (hasLink()) {
+    if (hasSelectedDelegation()) {
+      valueLength += encoding::sizeOfNonNegativeIntegerBlock(tlv::SelectedDelegation,
+                                                             m_selectedDelegationIndex);
+    }
+    valueLength += m_link.size();
+  }
+  if (getInterestLifetime() >= time::milliseconds::zero() &&
+      getInterestLifetime() != DEFAULT_INTEREST_LIFETIME) {
+    valueLength += encoding::sizeOfNonNegativeIntegerBlock(tlv::InterestLifetime,
+                                                           getInterestLifetime().count());
+  }
+  getNonce();
+  valueLength += m_nonce.size();
+  if (hasSelectors()) {
+    valueLength += getSelectors().wireEncode().size(); // cached, prepended as is
+  }
+  valueLength += getName().wireSize();
+  getDestinationFlag();
+  valueLength += m_dfBlock.size();
+  getFloodFlag();
+  valueLength += m_ffBlock.size();
 
-  EncodingBuffer buffer(estimatedSize, 0);
+  size_t totalLength = encoding::sizeOfBlock(tlv::Interest, valueLength);
+  EncodingBuffer buffer(totalLength, 0);
   wireEncode(buffer);
+  BOOST_ASSERT(buffer.size() == totalLength);
 
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+  // Nonce and flags are modified in place in the wire (setNonce, setFloodFlag,
+  // setDestinationFlag), so these blocks must point into the new wire.  Other fields keep their
+  // blocks, the wire does not need to be decoded again.
+  m_wire = buffer.block();
+
+  InterestElements elements;
+  findElementsInWireOrder(m_wire, elements); // always in wire order, encoded just above
+
+  m_ffBlock = makeElementBlock(m_wire, elements.element[ELEMENT_FLOOD_FLAG]);
+  m_dfBlock = makeElementBlock(m_wire, elements.element[ELEMENT_DESTINATION_FLAG]);
+  m_nonce = makeElementBlock(m_wire, elements.element[ELEMENT_NONCE]);
 
   return m_wire;
 }
@@ -316,52 +477,55 @@ void
 Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
-  m_wire.parse();
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
+  //                FloodFlag
+  //                DestinationFlag
   //                Name
   //                Selectors?
   //                Nonce
   //                InterestLifetime?
   //                Link?
   //                SelectedDelegation?
-  //                Destination Flag
-  //                Flood Flag
 
   if (m_wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
-  
+
+  // Interests produced by wireEncode are decoded in one pass over the wire; anything else
+  // goes through the generic (order-independent) lookup
+  InterestElements elements;
+  if (!findElementsInWireOrder(m_wire, elements))
+    findElements(m_wire, elements);
+
   // Flood Flag
-  m_ffBlock = m_wire.get(tlv::FloodFlag);
-  m_floodFlag.set(readNonNegativeInteger(m_ffBlock));
-  NS_LOG_INFO (">> WireDecode Flood Flag: " << m_floodFlag.get() << " "<<readNonNegativeInteger(m_ffBlock) << " "<<m_ffBlock.value_size());
+  const Element& floodFlag = elements.element[ELEMENT_FLOOD_FLAG];
+  m_ffBlock = makeElementBlock(m_wire, floodFlag);
+  m_floodFlag.set(encoding::ElementIndex::readNonNegativeInteger(floodFlag));
 
   // Destination Flag
-  m_dfBlock = m_wire.get(tlv::DestinationFlag);
-  m_destinationFlag.set(readNonNegativeInteger(m_dfBlock));
-  NS_LOG_INFO (">> WireDecode destination Flag: " << m_destinationFlag.get() << " "<<readNonNegativeInteger(m_dfBlock)<< " "<<m_dfBlock.value_size());
-  //m_destinationFlag.wireDecode(m_wire.get(tlv::DestinationFlag));
+  const Element& destinationFlag = elements.element[ELEMENT_DESTINATION_FLAG];
+  m_dfBlock = makeElementBlock(m_wire, destinationFlag);
+  m_destinationFlag.set(encoding::ElementIndex::readNonNegativeInteger(destinationFlag));
 
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  m_name.wireDecode(makeElementBlock(m_wire, elements.element[ELEMENT_NAME]));
 
   // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end())
+  if (elements.has[ELEMENT_SELECTORS])
     {
-      m_selectors.wireDecode(*val);
+      m_selectors.wireDecode(makeElementBlock(m_wire, elements.element[ELEMENT_SELECTORS]));
     }
   else
     m_selectors = Selectors();
 
   // Nonce
-  m_nonce = m_wire.get(tlv::Nonce);
+  m_nonce = makeElementBlock(m_wire, elements.element[ELEMENT_NONCE]);
 
   // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end())
+  if (elements.has[ELEMENT_INTEREST_LIFETIME])
     {
-      m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
+      m_interestLifetime = time::milliseconds(encoding::ElementIndex::readNonNegativeInteger(
+                             elements.element[ELEMENT_INTEREST_LIFETIME]));
     }
   else
     {
@@ -369,19 +533,18 @@ Interest::wireDecode(const Block& wire)
     }
 
   // Link object
-  val = m_wire.find(tlv::Data);
-  if (val != m_wire.elements_end())
+  if (elements.has[ELEMENT_LINK])
     {
-      m_link = (*val);
+      m_link = makeElementBlock(m_wire, elements.element[ELEMENT_LINK]);
     }
 
   // SelectedDelegation
-  val = m_wire.find(tlv::SelectedDelegation);
-  if (val != m_wire.elements_end()) {
+  if (elements.has[ELEMENT_SELECTED_DELEGATION]) {
     if (!this->hasLink()) {
       BOOST_THROW_EXCEPTION(Error("Interest contains selectedDelegation, but no LINK object"));
     }
-    uint64_t selectedDelegation = readNonNegativeInteger(*val);
+    uint64_t selectedDelegation = encoding::ElementIndex::readNonNegativeInteger(
+                                    elements.element[ELEMENT_SELECTED_DELEGATION]);
     if (selectedDelegation < uint64_t(Link::countDelegationsFromWire(m_link))) {
       m_selectedDelegationIndex = static_cast<size_t>(selectedDelegation);
     }
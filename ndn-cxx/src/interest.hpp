@@ -230,6 +230,14 @@ public: // Name and guiders
     m_wire.reset();
     return *this;
   }
+
+  Interest&
+  setName(Name&& name)
+  {
+    m_name = std::move(name);
+    m_wire.reset();
+    return *this;
+  }
   
   Interest&
   setDestinationFlag(uint32_t val)
@@ -129,6 +129,10 @@ template<encoding::Tag TAG>
 size_t
 MetaInfo::wireEncode(EncodingImpl<TAG>& encoder) const
 {
+  // every setter resets the wire, so the cached wire is up to date
+  if (m_wire.hasWire())
+    return encoder.prependBlock(m_wire);
+
   // MetaInfo ::= META-INFO-TYPE TLV-LENGTH
   //                ContentType?
   //                FreshnessPeriod?
@@ -28,6 +28,7 @@
 #include "util/time.hpp"
 #include "util/string-helper.hpp"
 #include "encoding/block.hpp"
+#include "encoding/block-helpers.hpp"
 #include "encoding/encoding-buffer.hpp"
 
 #include <boost/functional/hash.hpp>
@@ -68,6 +69,10 @@ template<encoding::Tag TAG>
 size_t
 Name::wireEncode(EncodingImpl<TAG>& encoder) const
 {
+  // components are not modified without resetting the wire, so the cached wire is up to date
+  if (m_nameBlock.hasWire())
+    return encoder.prependBlock(m_nameBlock);
+
   size_t totalLength = 0;
 
   for (const_reverse_iterator i = rbegin(); i != rend(); ++i)
@@ -104,6 +109,19 @@ Name::wireEncode() const
   return m_nameBlock;
 }
 
+size_t
+Name::wireSize() const
+{
+  if (m_nameBlock.hasWire())
+    return m_nameBlock.size();
+
+  size_t valueLength = 0;
+  for (const Component& component : *this) {
+    valueLength += encoding::sizeOfBlock(component.type(), component.value_size());
+  }
+  return encoding::sizeOfBlock(tlv::Name, valueLength);
+}
+
 void
 Name::wireDecode(const Block& wire)
 {
@@ -117,6 +117,14 @@ public:
   const Block&
   wireEncode() const;
 
+  /**
+   * @brief Get the size of the wire encoding without encoding the name
+   *
+   * If the name does not have wire, the size is computed from the sizes of the components.
+   */
+  size_t
+  wireSize() const;
+
   void
   wireDecode(const Block& wire);
 
@@ -700,7 +700,7 @@ KeyChain::signPacketWrapper(Data& data, const Signature& signature,
 {
   data.setSignature(signature);
 
-  EncodingBuffer encoder;
+  EncodingBuffer encoder(encoding::ReusableBufferTag{});
   data.wireEncode(encoder, true);
 
   Block sigValue = pureSign(encoder.buf(), encoder.size(), keyName, digestAlgorithm);
@@ -60,6 +60,10 @@ template<encoding::Tag TAG>
 size_t
 Selectors::wireEncode(EncodingImpl<TAG>& encoder) const
 {
+  // every setter resets the wire, so the cached wire is up to date
+  if (m_wire.hasWire())
+    return encoder.prependBlock(m_wire);
+
   size_t totalLength = 0;
 
   // Selectors ::= SELECTORS-TYPE TLV-LENGTH
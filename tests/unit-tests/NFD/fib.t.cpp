@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "NFD/daemon/table/fib.hpp"
+#include "NFD/daemon/table/measurements.hpp"
+#include "NFD/daemon/face/null-face.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::Fib;
+using nfd::NameTree;
+using nfd::Measurements;
+namespace fib = nfd::fib;
+
+class FibNumericFixture : public CleanupFixture
+{
+public:
+  FibNumericFixture()
+    : fib(nameTree)
+    , face1(make_shared<nfd::NullFace>(FaceUri("null://1")))
+    , face2(make_shared<nfd::NullFace>(FaceUri("null://2")))
+  {
+  }
+
+public:
+  NameTree nameTree;
+  Fib fib;
+  shared_ptr<nfd::Face> face1;
+  shared_ptr<nfd::Face> face2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdFib, FibNumericFixture)
+
+BOOST_AUTO_TEST_CASE(NumericPrefixes)
+{
+  fib.insert("ndn:/prefix/1").first->addNextHop(face1, 10); // moved into the array
+  fib.setNumericRoot("ndn:/prefix");
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+
+  for (uint64_t i = 2; i < 10; ++i) {
+    std::pair<shared_ptr<fib::Entry>, bool> inserted =
+      fib.insert(Name("ndn:/prefix").appendNumber(i));
+    BOOST_CHECK(inserted.second);
+    inserted.first->addNextHop(i % 2 == 0 ? face2 : face1, 10);
+  }
+  BOOST_CHECK_EQUAL(fib.size(), 9);
+
+  shared_ptr<fib::Entry> entry = fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(3)
+                                                              .append("chunk").appendNumber(7));
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getFace(), face1);
+
+  // prefixes with identical nexthops share an entry
+  BOOST_CHECK_EQUAL(fib.getNNumericEntryObjects(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(4)),
+                    fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(6)));
+
+  // modifying an exact-match entry does not affect other prefixes
+  shared_ptr<fib::Entry> entry4 = fib.findExactMatch(Name("ndn:/prefix").appendNumber(4));
+  BOOST_REQUIRE(static_cast<bool>(entry4));
+  BOOST_CHECK_EQUAL(entry4->getPrefix(), Name("ndn:/prefix").appendNumber(4));
+  entry4->addNextHop(face1, 20);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(4))
+                      ->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(6))
+                      ->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(fib.getNNumericEntryObjects(), 3);
+
+  // absent numeric prefix and non-numeric names fall back to the NameTree
+  fib.insert("ndn:/prefix").first->addNextHop(face2, 5);
+  fib.insert("ndn:/other").first->addNextHop(face1, 5);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(100))
+                      ->getPrefix(), Name("ndn:/prefix"));
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("ndn:/other/A")->getPrefix(), Name("ndn:/other"));
+
+  // a more specific NameTree prefix takes precedence over the numeric entry
+  Name specific = Name("ndn:/prefix").appendNumber(5).append("special");
+  fib.insert(specific).first->addNextHop(face2, 5);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name(specific).append("x"))->getPrefix(), specific);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(5).append("x"))
+                      ->getNextHops().front().getFace(), face1);
+  fib.erase(specific);
+
+  fib.erase(Name("ndn:/prefix").appendNumber(3));
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(3))->getPrefix(),
+                    Name("ndn:/prefix"));
+  BOOST_CHECK(!static_cast<bool>(fib.findExactMatch(Name("ndn:/prefix").appendNumber(3))));
+  BOOST_CHECK_EQUAL(fib.size(), 10);
+
+  // face1 was the only nexthop of odd prefixes
+  fib.removeNextHopFromAllEntries(face1);
+  BOOST_CHECK(!static_cast<bool>(fib.findExactMatch(Name("ndn:/prefix").appendNumber(5))));
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(4))
+                      ->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(fib.getNNumericEntryObjects(), 1);
+  BOOST_CHECK_EQUAL(fib.size(), 5); // /prefix, /prefix/2, /prefix/4, /prefix/6, /prefix/8
+}
+
+BOOST_AUTO_TEST_CASE(NumericMeasurements)
+{
+  fib.setNumericRoot("ndn:/prefix");
+  fib.insert(Name("ndn:/prefix").appendNumber(1)).first->addNextHop(face1, 10);
+  fib.insert(Name("ndn:/prefix").appendNumber(2)).first->addNextHop(face1, 10);
+
+  Measurements measurements(nameTree);
+
+  // shared entry stands for several prefixes, it is not merged into the root's measurements
+  shared_ptr<fib::Entry> shared = fib.findLongestPrefixMatch(Name("ndn:/prefix").appendNumber(1));
+  BOOST_REQUIRE(shared != nullptr);
+  BOOST_CHECK(shared->isShared());
+  BOOST_CHECK(nameTree.get(*shared) == nullptr);
+  BOOST_CHECK(measurements.get(*shared) == nullptr);
+  BOOST_CHECK(measurements.findExactMatch("ndn:/prefix") == nullptr);
+
+  // private entries get the Measurements entries of their own prefixes
+  shared_ptr<fib::Entry> entry1 = fib.findExactMatch(Name("ndn:/prefix").appendNumber(1));
+  shared_ptr<fib::Entry> entry2 = fib.findExactMatch(Name("ndn:/prefix").appendNumber(2));
+  BOOST_REQUIRE(entry1 != nullptr && entry2 != nullptr);
+  BOOST_CHECK(!entry1->isShared());
+  shared_ptr<nfd::measurements::Entry> measurements1 = measurements.get(*entry1);
+  shared_ptr<nfd::measurements::Entry> measurements2 = measurements.get(*entry2);
+  BOOST_REQUIRE(measurements1 != nullptr && measurements2 != nullptr);
+  BOOST_CHECK_EQUAL(measurements1->getName(), Name("ndn:/prefix").appendNumber(1));
+  BOOST_CHECK_EQUAL(measurements2->getName(), Name("ndn:/prefix").appendNumber(2));
+  BOOST_CHECK(measurements1 != measurements2);
+
+  // measurements of Interest names stay separate per numeric prefix
+  shared_ptr<nfd::measurements::Entry> chunk1 =
+    measurements.get(Name("ndn:/prefix").appendNumber(1).appendNumber(7));
+  shared_ptr<nfd::measurements::Entry> chunk2 =
+    measurements.get(Name("ndn:/prefix").appendNumber(2).appendNumber(7));
+  BOOST_CHECK_EQUAL(measurements.getParent(*chunk1), measurements1);
+  BOOST_CHECK_EQUAL(measurements.getParent(*chunk2), measurements2);
+}
+
+BOOST_AUTO_TEST_CASE(NumericEnumeration)
+{
+  fib.setNumericRoot("ndn:/prefix");
+  fib.insert("ndn:/other").first->addNextHop(face2, 5);
+  for (uint64_t i = 1; i <= 4; ++i) {
+    fib.insert(Name("ndn:/prefix").appendNumber(i)).first->addNextHop(face1, 10);
+  }
+  fib.erase(Name("ndn:/prefix").appendNumber(3));
+  BOOST_CHECK_EQUAL(fib.getNNumericEntryObjects(), 1);
+
+  // every prefix is enumerated once with its own name, including prefixes sharing an entry
+  std::set<Name> prefixes;
+  size_t nEntries = 0;
+  for (const fib::Entry& entry : fib) {
+    prefixes.insert(entry.getPrefix());
+    BOOST_CHECK_EQUAL(entry.getNextHops().size(), 1);
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, fib.size());
+  BOOST_CHECK_EQUAL(nEntries, 4);
+  BOOST_CHECK_EQUAL(prefixes.count("ndn:/other"), 1);
+  BOOST_CHECK_EQUAL(prefixes.count(Name("ndn:/prefix").appendNumber(1)), 1);
+  BOOST_CHECK_EQUAL(prefixes.count(Name("ndn:/prefix").appendNumber(2)), 1);
+  BOOST_CHECK_EQUAL(prefixes.count(Name("ndn:/prefix").appendNumber(4)), 1);
+
+  // enumeration does not detach shared entries
+  BOOST_CHECK_EQUAL(fib.getNNumericEntryObjects(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-sit.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerSitFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerSitFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  Ptr<ConsumerSit>
+  getConsumer()
+  {
+    Ptr<ConsumerSit> consumer = DynamicCast<ConsumerSit>(getNode("1")->GetApplication(0));
+    consumer->TraceConnectWithoutContext("TransmittedInterests",
+                                         MakeCallback(&ConsumerSitFixture::onInterest, this));
+    consumer->TraceConnectWithoutContext("FlowCompletion",
+                                         MakeCallback(&ConsumerSitFixture::onFlowCompletion, this));
+    consumer->TraceConnectWithoutContext("FlowAbort",
+                                         MakeCallback(&ConsumerSitFixture::onFlowAbort, this));
+    consumer->TraceConnectWithoutContext("FlowWindow",
+                                         MakeCallback(&ConsumerSitFixture::onFlowWindow, this));
+    return consumer;
+  }
+
+  void
+  onInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    sentInterests.push_back(std::make_tuple(Simulator::Now(),
+                                            interest->getName().at(-1).toSequenceNumber(),
+                                            interest->getFloodFlag()));
+  }
+
+  void
+  onFlowCompletion(Ptr<App>, uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks,
+                   Time completionTime)
+  {
+    completedFlows.push_back(std::make_tuple(prefixNumber, firstChunk, nChunks, completionTime));
+  }
+
+  void
+  onFlowAbort(Ptr<App>, uint32_t prefixNumber, uint32_t firstChunk, uint32_t nChunks,
+              Time abortTime)
+  {
+    abortedFlows.push_back(std::make_tuple(prefixNumber, firstChunk, nChunks, abortTime));
+  }
+
+  void
+  onFlowWindow(Ptr<App>, uint32_t, uint32_t, double window)
+  {
+    windows.push_back(window);
+  }
+
+public:
+  std::vector<std::tuple<Time, uint64_t, uint32_t>> sentInterests; // time, chunk, scope
+  std::vector<std::tuple<uint32_t, uint32_t, uint32_t, Time>> completedFlows;
+  std::vector<std::tuple<uint32_t, uint32_t, uint32_t, Time>> abortedFlows;
+  std::vector<double> windows;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerSit, ConsumerSitFixture)
+
+BOOST_AUTO_TEST_CASE(WindowedRetrieval)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerSit", {{"Prefix", "/prefix"}}, "0s", "100s"},
+      {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "0s", "100s"}
+    });
+  Ptr<ConsumerSit> consumer = getConsumer();
+
+  Simulator::Schedule(Seconds(1), &ConsumerSit::RequestContent, consumer, 7, 100, 10, 0);
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(completedFlows.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(completedFlows[0]), 7);
+  BOOST_CHECK_EQUAL(std::get<1>(completedFlows[0]), 100);
+  BOOST_CHECK_EQUAL(std::get<2>(completedFlows[0]), 10);
+  BOOST_CHECK_GT(std::get<3>(completedFlows[0]), Time());
+  BOOST_CHECK_EQUAL(consumer->GetNActiveFlows(), 0);
+
+  // every chunk is requested once, the second one only after Data of the first arrived
+  BOOST_REQUIRE_EQUAL(sentInterests.size(), 10);
+  for (uint32_t i = 0; i < sentInterests.size(); i++) {
+    BOOST_CHECK_EQUAL(std::get<1>(sentInterests[i]), 100 + i);
+  }
+  BOOST_CHECK_EQUAL(std::get<0>(sentInterests[0]), Seconds(1));
+  BOOST_CHECK_GT(std::get<0>(sentInterests[1]), Seconds(1));
+
+  // window grows, so the content takes less than one RTT per chunk
+  Time rtt = std::get<0>(sentInterests[1]) - std::get<0>(sentInterests[0]);
+  BOOST_CHECK_LT(std::get<3>(completedFlows[0]), rtt * 10);
+}
+
+BOOST_AUTO_TEST_CASE(FollowUpScope)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerSit",
+          {{"Prefix", "/prefix"}, {"FollowUpScope", "0"}, {"InitialWindow", "2"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "0s", "100s"}
+    });
+  Ptr<ConsumerSit> consumer = getConsumer();
+
+  Simulator::Schedule(Seconds(1), &ConsumerSit::RequestContent, consumer, 0, 0, 4, 3);
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(completedFlows.size(), 1);
+  BOOST_REQUIRE_EQUAL(sentInterests.size(), 4);
+
+  // initial window is sent with the scope of the request
+  BOOST_CHECK_EQUAL(std::get<2>(sentInterests[0]), 3);
+  BOOST_CHECK_EQUAL(std::get<2>(sentInterests[1]), 3);
+  BOOST_CHECK_EQUAL(std::get<2>(sentInterests[2]), 0);
+  BOOST_CHECK_EQUAL(std::get<2>(sentInterests[3]), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Retransmission)
+{
+  // producer starts after the initial window has been sent, so all its chunks time out
+  addApps({
+      {"1", "ns3::ndn::ConsumerSit", {{"Prefix", "/prefix"}, {"InitialWindow", "4"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "1.5s", "100s"}
+    });
+  Ptr<ConsumerSit> consumer = getConsumer();
+
+  Simulator::Schedule(Seconds(1), &ConsumerSit::RequestContent, consumer, 0, 0, 8, 0);
+
+  Simulator::Stop(Seconds(30));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(completedFlows.size(), 1);
+  BOOST_CHECK_EQUAL(abortedFlows.size(), 0);
+  BOOST_CHECK_EQUAL(consumer->GetNActiveFlows(), 0);
+
+  // timed-out chunks are retransmitted together, in the order they were sent
+  BOOST_REQUIRE_GE(sentInterests.size(), 12);
+  for (uint32_t i = 0; i < 4; i++) {
+    BOOST_CHECK_EQUAL(std::get<0>(sentInterests[i]), Seconds(1));
+    BOOST_CHECK_EQUAL(std::get<1>(sentInterests[i]), i);
+    BOOST_CHECK_GT(std::get<0>(sentInterests[4 + i]), Seconds(1.5));
+    BOOST_CHECK_EQUAL(std::get<0>(sentInterests[4 + i]), std::get<0>(sentInterests[4]));
+    BOOST_CHECK_EQUAL(std::get<1>(sentInterests[4 + i]), i);
+  }
+
+  // the window is halved once for the whole window of timed-out chunks
+  BOOST_REQUIRE(!windows.empty());
+  BOOST_CHECK_EQUAL(windows[0], 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(GiveUp)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerSit",
+          {{"Prefix", "/prefix"}, {"InitialWindow", "2"}, {"MaxRetransmissions", "2"}},
+          "0s", "100s"}
+    });
+  Ptr<ConsumerSit> consumer = getConsumer();
+
+  Simulator::Schedule(Seconds(1), &ConsumerSit::RequestContent, consumer, 3, 0, 4, 0);
+
+  Simulator::Stop(Seconds(90));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(completedFlows.size(), 0);
+  BOOST_REQUIRE_EQUAL(abortedFlows.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(abortedFlows[0]), 3);
+  BOOST_CHECK_EQUAL(std::get<1>(abortedFlows[0]), 0);
+  BOOST_CHECK_EQUAL(std::get<2>(abortedFlows[0]), 4);
+  BOOST_CHECK_EQUAL(consumer->GetNActiveFlows(), 0);
+
+  // both chunks of the window are sent once and retransmitted twice, nothing after giving up
+  BOOST_REQUIRE_EQUAL(sentInterests.size(), 6);
+  for (const auto& sent : sentInterests) {
+    BOOST_CHECK_LT(std::get<1>(sent), 2);
+    BOOST_CHECK_LT(std::get<0>(sent), Seconds(1) + std::get<3>(abortedFlows[0]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
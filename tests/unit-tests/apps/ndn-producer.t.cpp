@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProducerFixture()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    sentData.push_back(data);
+  }
+
+  /**
+   * @brief Data created the way Producer created it before the template was introduced
+   */
+  static shared_ptr<Data>
+  makeReference(const Name& name, uint32_t payloadSize, const time::milliseconds& freshness,
+                uint32_t signatureValue, const Name& keyLocator)
+  {
+    auto data = make_shared<Data>();
+    data->setName(name);
+    data->setFreshnessPeriod(freshness);
+    data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    if (keyLocator.size() > 0) {
+      signatureInfo.setKeyLocator(keyLocator);
+    }
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signatureValue));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+public:
+  std::vector<shared_ptr<const Data>> sentData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(SameAsReference)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr", {{"Prefix", "/prefix"}, {"Frequency", "10"}}, "0s", "0.45s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "700"}, {"Freshness", "2s"},
+           {"Signature", "7"}, {"KeyLocator", "/key"}},
+          "0s", "100s"}
+    });
+  getNode("2")->GetApplication(0)->TraceConnectWithoutContext(
+    "TransmittedDatas", MakeCallback(&ProducerFixture::onData, this));
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_REQUIRE_GT(sentData.size(), 1);
+  for (const shared_ptr<const Data>& data : sentData) {
+    auto reference = makeReference(data->getName(), 700, time::seconds(2), 7, "/key");
+    BOOST_CHECK_EQUAL(data->getName(), reference->getName());
+    BOOST_CHECK_EQUAL(data->getContent().value_size(), 700);
+    BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), time::seconds(2));
+    BOOST_CHECK_EQUAL(data->getSignature().getType(), 255);
+    BOOST_CHECK_EQUAL(data->getSignature().getKeyLocator().getName(), Name("/key"));
+    BOOST_CHECK(data->getSignature().getValue() == reference->getSignature().getValue());
+    BOOST_CHECK(data->wireEncode() == reference->wireEncode());
+  }
+
+  // the template is not modified by the packets created from it
+  BOOST_CHECK_NE(sentData[0]->getName(), sentData[1]->getName());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
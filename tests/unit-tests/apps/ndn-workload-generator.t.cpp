@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-workload-generator.hpp"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+class WorkloadGeneratorFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  WorkloadGeneratorFixture()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+  }
+
+  /**
+   * @brief Run the generator with the specified attributes and collect requested contents
+   */
+  void
+  run(std::initializer_list<std::pair<const std::string, std::string>> params)
+  {
+    std::map<std::string, std::string> attributes = {{"ArrivalRate", "100"},
+                                                     {"InitFraction", "0"},
+                                                     {"InitGap", "0s"},
+                                                     {"ObservationLength", "2s"}};
+    for (const auto& param : params) {
+      attributes[param.first] = param.second;
+    }
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerSit", {{"Prefix", "/prefix"}}, "0s", "100s"},
+        {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "0s", "100s"}
+      });
+
+    ApplicationContainer consumers(getNode("1")->GetApplication(0));
+    consumers.Get(0)->TraceConnectWithoutContext("TransmittedInterests",
+                                                 MakeCallback(&WorkloadGeneratorFixture::onInterest,
+                                                              this));
+
+    Ptr<WorkloadGenerator> generator = CreateObject<WorkloadGenerator>();
+    for (const auto& attribute : attributes) {
+      generator->SetAttribute(attribute.first, StringValue(attribute.second));
+    }
+    generator->SetConsumers(consumers);
+    generator->SetProducerNodes(NodeContainer(getNode("2")));
+    getNode("1")->AddApplication(generator);
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+  }
+
+  void
+  onInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    contents.push_back(interest->getName().at(-1).toSequenceNumber());
+  }
+
+public:
+  std::vector<uint64_t> contents;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnWorkloadGenerator, WorkloadGeneratorFixture)
+
+BOOST_AUTO_TEST_CASE(FewContents)
+{
+  run({{"NumberOfContents", "10"}, {"s", "0.8"}});
+
+  BOOST_CHECK_GT(contents.size(), 100);
+  for (uint64_t content : contents) {
+    BOOST_CHECK_GE(content, 1);
+    BOOST_CHECK_LE(content, 10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ManyContents)
+{
+  // uniform popularity, more contents than the ConsumerZipfMandelbrot default
+  run({{"NumberOfContents", "1000"}, {"q", "0"}, {"s", "0"}});
+
+  BOOST_CHECK_GT(contents.size(), 100);
+  BOOST_CHECK_GT(*std::max_element(contents.begin(), contents.end()), 100);
+  BOOST_CHECK_LE(*std::max_element(contents.begin(), contents.end()), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
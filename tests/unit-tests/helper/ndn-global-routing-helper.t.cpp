@@ -41,6 +41,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TOPO_TXT = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+const boost::filesystem::path TEST_ROUTES = boost::filesystem::path(TEST_CONFIG_PATH) / "routes.bin";
 
 class GlobalRoutingHelperFixture : public CleanupFixture
 {
@@ -53,6 +54,7 @@ public:
   ~GlobalRoutingHelperFixture()
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
+    boost::filesystem::remove(TEST_ROUTES);
   }
 };
 
@@ -146,6 +148,141 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(PathCosts)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n"
+        << "D3  NA  80  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n"
+        << "C3      D3  10Mbps    2 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> a = Names::Find<Node>("A3");
+  Ptr<Node> b = Names::Find<Node>("B3");
+  Ptr<Node> c = Names::Find<Node>("C3");
+  Ptr<Node> d = Names::Find<Node>("D3");
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix/c", c);
+  ndnGlobalRoutingHelper.AddOrigins("/prefix/d", d);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(a, c), 50);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(b, c), 1);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(c, c), 0);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(a, d), 52);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(b, d), 3);
+
+  // A3 and B3 are not origins
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(c, a),
+                    ndn::GlobalRoutingHelper::UNREACHABLE);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(d, b),
+                    ndn::GlobalRoutingHelper::UNREACHABLE);
+
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetDiameter(), 52);
+
+  // costs must match what is installed in FIB
+  auto ndn = a->GetObject<ndn::L3Protocol>();
+  auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix/d");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE(entry->hasNextHops());
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(),
+                    ndn::GlobalRoutingHelper::GetPathCost(a, d));
+}
+
+BOOST_AUTO_TEST_CASE(RouteCache)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    100 1ms 100\n"
+        << "A4      C4  10Mbps    50  1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  Ptr<Node> a = Names::Find<Node>("A4");
+  Ptr<Node> c = Names::Find<Node>("C4");
+  ndnGlobalRoutingHelper.AddOrigins("/prefix/c", c);
+
+  // first run calculates routes and creates the cache
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), false);
+  BOOST_CHECK(boost::filesystem::exists(TEST_ROUTES));
+
+  nfd::Fib& fib = a->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  auto entry = fib.findExactMatch("/prefix/c");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  nfd::FaceId faceId = entry->getNextHops()[0].getFace()->getId();
+  uint64_t cost = entry->getNextHops()[0].getCost();
+
+  // second run installs the same routes from the cache
+  fib.erase("/prefix/c");
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), true);
+
+  entry = fib.findExactMatch("/prefix/c");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getFace()->getId(), faceId);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].getCost(), cost);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetPathCost(a, c), 50);
+
+  // a corrupted cache is recalculated and replaced
+  boost::filesystem::resize_file(TEST_ROUTES, boost::filesystem::file_size(TEST_ROUTES) - 1);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), false);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), true);
+
+  // any change of the routing input invalidates the cache
+  uint64_t fingerprint = ndn::GlobalRoutingHelper::GetRoutingFingerprint();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix/a", a);
+  BOOST_CHECK_NE(ndn::GlobalRoutingHelper::GetRoutingFingerprint(), fingerprint);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), false);
+  BOOST_CHECK(fib.findExactMatch("/prefix/a") == nullptr); // A is the origin itself
+  BOOST_CHECK(c->GetObject<ndn::L3Protocol>()->getForwarder()->getFib()
+                .findExactMatch("/prefix/a") != nullptr);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutes(TEST_ROUTES.string()), true);
+
+  // temporary files have been renamed into place
+  for (boost::filesystem::directory_iterator i(TEST_CONFIG_PATH), end; i != end; ++i) {
+    BOOST_CHECK_NE(i->path().extension(), ".tmp");
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-face.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "ns3/node.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Application that records names of the delivered packets
+ */
+class RecordingApp : public App {
+public:
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest)
+  {
+    delivered.push_back("I:" + interest->getName().toUri());
+    if (onInterest)
+      onInterest(*interest);
+  }
+
+  virtual void
+  OnData(shared_ptr<const Data> data)
+  {
+    delivered.push_back("D:" + data->getName().toUri());
+  }
+
+public:
+  std::vector<std::string> delivered;
+  std::function<void(const Interest&)> onInterest;
+};
+
+class AppFaceFixture : public CleanupFixture
+{
+public:
+  AppFaceFixture()
+    : app(CreateObject<RecordingApp>())
+  {
+    app->SetNode(CreateObject<Node>());
+    face = make_shared<AppFace>(app);
+  }
+
+public:
+  Ptr<RecordingApp> app;
+  shared_ptr<AppFace> face;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppFace, AppFaceFixture)
+
+BOOST_AUTO_TEST_CASE(Fifo)
+{
+  face->sendInterest(*make_shared<Interest>("/a"));
+  face->sendData(*make_shared<Data>("/b"));
+  face->sendInterest(*make_shared<Interest>("/c"));
+  BOOST_CHECK(app->delivered.empty()); // never synchronously
+
+  Simulator::Run();
+  std::vector<std::string> expected = {"I:/a", "D:/b", "I:/c"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(app->delivered.begin(), app->delivered.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(QueuedDuringDelivery)
+{
+  app->onInterest = [this] (const Interest& interest) {
+    if (interest.getName() == "/a")
+      face->sendData(*make_shared<Data>("/reply"));
+  };
+
+  face->sendInterest(*make_shared<Interest>("/a"));
+  face->sendData(*make_shared<Data>("/b"));
+
+  Simulator::Run();
+  std::vector<std::string> expected = {"I:/a", "D:/b", "D:/reply"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(app->delivered.begin(), app->delivered.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(InterleavedFaces)
+{
+  Ptr<RecordingApp> otherApp = CreateObject<RecordingApp>();
+  otherApp->SetNode(CreateObject<Node>());
+  shared_ptr<AppFace> otherFace = make_shared<AppFace>(otherApp);
+
+  // both applications record into the same log to observe the global order
+  std::vector<std::string> delivered;
+  app->onInterest = [&delivered] (const Interest& interest) {
+    delivered.push_back("1:" + interest.getName().toUri());
+  };
+  otherApp->onInterest = [&delivered] (const Interest& interest) {
+    delivered.push_back("2:" + interest.getName().toUri());
+  };
+
+  face->sendInterest(*make_shared<Interest>("/a"));
+  otherFace->sendInterest(*make_shared<Interest>("/b"));
+  face->sendInterest(*make_shared<Interest>("/c"));
+  otherFace->sendInterest(*make_shared<Interest>("/d"));
+
+  Simulator::Run();
+  std::vector<std::string> expected = {"1:/a", "2:/b", "1:/c", "2:/d"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(delivered.begin(), delivered.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(DestroyedWithPendingDelivery)
+{
+  face->sendInterest(*make_shared<Interest>("/a"));
+  face.reset();
+
+  Simulator::Run();
+  BOOST_CHECK(app->delivered.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ReleasedDuringDelivery)
+{
+  Ptr<RecordingApp> otherApp = CreateObject<RecordingApp>();
+  otherApp->SetNode(CreateObject<Node>());
+  shared_ptr<AppFace> otherFace = make_shared<AppFace>(otherApp);
+
+  app->onInterest = [&otherFace] (const Interest&) {
+    otherFace.reset();
+  };
+
+  face->sendInterest(*make_shared<Interest>("/a"));
+  otherFace->sendInterest(*make_shared<Interest>("/b"));
+  face->sendInterest(*make_shared<Interest>("/c"));
+
+  Simulator::Run();
+  std::vector<std::string> expected = {"I:/a", "I:/c"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(app->delivered.begin(), app->delivered.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK(otherApp->delivered.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
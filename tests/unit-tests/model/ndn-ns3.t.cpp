@@ -21,6 +21,8 @@
 #include "helper/ndn-stack-helper.hpp"
 #include "model/ndn-header.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-wire-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -54,6 +56,126 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(SharedWire)
+{
+  auto data = std::make_shared<ndn::Data>("/prefix/data");
+  data->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+
+  // received in the same process: decoded packet and wire buffer are shared
+  Ptr<Packet> received = packet->Copy();
+  auto shared = Convert::FromPacket<ndn::Data>(received);
+  BOOST_CHECK_EQUAL(*shared, *data);
+  BOOST_CHECK(shared->wireEncode().wire() == data->wireEncode().wire());
+  BOOST_CHECK_EQUAL(received->GetSize(), 0);
+
+  WireTag wireTag;
+  BOOST_CHECK_EQUAL(received->PeekPacketTag(wireTag), false);
+
+  // without the tag, the packet is decoded from its bytes
+  Ptr<Packet> untagged = packet->Copy();
+  untagged->RemovePacketTag(wireTag);
+  auto decoded = Convert::FromPacket<ndn::Data>(untagged);
+  BOOST_CHECK_EQUAL(*decoded, *data);
+  BOOST_CHECK(decoded->wireEncode().wire() != data->wireEncode().wire());
+  BOOST_CHECK_EQUAL(untagged->GetSize(), 0);
+
+  // changes of the sender's Data and its LocalControlHeader are not seen by the receivers
+  data->setIncomingFaceId(5);
+  Ptr<Packet> packet2 = Convert::ToPacket(*data);
+  data->setContent(std::make_shared< ::ndn::Buffer>(10));
+  auto received2 = Convert::FromPacket<ndn::Data>(packet2);
+  BOOST_CHECK_EQUAL(received2->getContent().value_size(), 1024);
+  BOOST_CHECK(!received2->getLocalControlHeader().hasIncomingFaceId());
+}
+
+BOOST_AUTO_TEST_CASE(ForeignWireTag)
+{
+  auto data1 = std::make_shared<ndn::Data>("/prefix/data1");
+  data1->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data1);
+  auto data2 = std::make_shared<ndn::Data>("/prefix/data2");
+  data2->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data2);
+
+  Ptr<Packet> packet1 = Convert::ToPacket(*data1);
+  Ptr<Packet> packet2 = Convert::ToPacket(*data2);
+  WireTag tag1;
+  BOOST_REQUIRE(packet1->RemovePacketTag(tag1));
+  BOOST_CHECK_EQUAL(tag1.GetProcess(), WireTag::GetCurrentProcess());
+  WireTag tag2;
+  BOOST_REQUIRE(packet2->RemovePacketTag(tag2));
+
+  // identifier assigned by another process (e.g., another MPI rank) is not looked up
+  packet2->AddPacketTag(WireTag(WireTag::GetCurrentProcess() + 1, tag1.Get()));
+  auto received2 = Convert::FromPacket<ndn::Data>(packet2);
+  BOOST_CHECK_EQUAL(received2->getName(), "/prefix/data2");
+  BOOST_CHECK(received2->wireEncode().wire() != data1->wireEncode().wire());
+
+  // snapshot is used only when its size is exactly the size of the packet
+  Ptr<Packet> padded = Convert::ToPacket(*data1);
+  padded->AddAtEnd(Create<Packet>(1));
+  auto receivedPadded = Convert::FromPacket<ndn::Data>(padded);
+  BOOST_CHECK_EQUAL(*receivedPadded, *data1);
+  BOOST_CHECK(receivedPadded->wireEncode().wire() != data1->wireEncode().wire());
+}
+
+BOOST_AUTO_TEST_CASE(InterestPerFace)
+{
+  // forwarder sends the same Interest object to two faces, rewriting it in between
+  auto interest = make_shared<ndn::Interest>("/prefix/interest");
+  interest->setNonce(1);
+  interest->setFloodFlag(2);
+  interest->setDestinationFlag(3);
+  Ptr<Packet> packet1 = Convert::ToPacket(*interest);
+
+  interest->setNonce(4); // in place, in the wire serialized to packet1
+  interest->setFloodFlag(5);
+  interest->setDestinationFlag(6);
+  Ptr<Packet> packet2 = Convert::ToPacket(*interest);
+
+  WireTag wireTag;
+  BOOST_CHECK_EQUAL(packet1->PeekPacketTag(wireTag), false);
+
+  auto received1 = Convert::FromPacket<ndn::Interest>(packet1);
+  auto received2 = Convert::FromPacket<ndn::Interest>(packet2);
+  BOOST_CHECK_EQUAL(received1->getNonce(), 1);
+  BOOST_CHECK_EQUAL(received1->getFloodFlag(), 2);
+  BOOST_CHECK_EQUAL(received1->getDestinationFlag(), 3);
+  BOOST_CHECK_EQUAL(received2->getNonce(), 4);
+  BOOST_CHECK_EQUAL(received2->getFloodFlag(), 5);
+  BOOST_CHECK_EQUAL(received2->getDestinationFlag(), 6);
+
+  // receivers do not share the wire with each other or with the sender
+  const_pointer_cast<ndn::Interest>(received1)->setNonce(7);
+  const_pointer_cast<ndn::Interest>(received1)->setFloodFlag(8);
+  BOOST_CHECK_EQUAL(received2->getNonce(), 4);
+  BOOST_CHECK_EQUAL(received2->getFloodFlag(), 5);
+  BOOST_CHECK_EQUAL(interest->getNonce(), 4);
+  BOOST_CHECK_EQUAL(interest->getFloodFlag(), 5);
+  BOOST_CHECK_EQUAL(ndn::Interest(received2->wireEncode()).getNonce(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(HopCount)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  interest->setNonce(1);
+  Ptr<Packet> packet = Convert::ToPacket(*interest);
+  FwHopCountTag hopCountTag;
+  BOOST_CHECK_EQUAL(packet->PeekPacketTag(hopCountTag), false);
+
+  packet->AddPacketTag(FwHopCountTag(3));
+  auto received = Convert::FromPacket<ndn::Interest>(packet);
+  auto tag = received->getTag<Ns3PacketTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->getHopCount(), 3);
+
+  Ptr<Packet> forwarded = Convert::ToPacket(*received);
+  BOOST_REQUIRE(forwarded->PeekPacketTag(hopCountTag));
+  BOOST_CHECK_EQUAL(hopCountTag.Get(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+namespace tlv = ::ndn::tlv;
+
+class DataEncodeFixture : public CleanupFixture
+{
+public:
+  DataEncodeFixture()
+    : data(Name("/prefix/a/b"))
+  {
+    data.setFreshnessPeriod(time::seconds(10));
+    data.setContent(make_shared< ::ndn::Buffer>(1024));
+
+    SignatureInfo signatureInfo(static_cast<tlv::SignatureTypeValue>(255));
+    signatureInfo.setKeyLocator(Name("/key"));
+    Signature signature(signatureInfo, ::ndn::nonNegativeIntegerBlock(tlv::SignatureValue, 7));
+    data.setSignature(signature);
+  }
+
+  void
+  checkDecoded(const Data& decoded)
+  {
+    BOOST_CHECK_EQUAL(decoded.getName(), data.getName());
+    BOOST_CHECK_EQUAL(decoded.getFreshnessPeriod(), time::seconds(10));
+    BOOST_CHECK_EQUAL(decoded.getContent().value_size(), 1024);
+    BOOST_CHECK_EQUAL(decoded.getSignature().getType(), 255);
+    BOOST_CHECK_EQUAL(decoded.getSignature().getKeyLocator().getName(), Name("/key"));
+    BOOST_CHECK_EQUAL(::ndn::readNonNegativeInteger(decoded.getSignature().getValue()), 7);
+  }
+
+public:
+  Data data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxDataEncode, DataEncodeFixture)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  const Block& wire = data.wireEncode();
+
+  Data decoded(Block(wire.wire(), wire.size()));
+  checkDecoded(decoded);
+  BOOST_CHECK(decoded.wireEncode() == wire);
+
+  // fields that were not decoded again still encode the same
+  checkDecoded(data);
+  BOOST_CHECK(Data(wire) == data);
+}
+
+BOOST_AUTO_TEST_CASE(ExactSize)
+{
+  ::ndn::EncodingEstimator estimator;
+  size_t expectedSize = data.wireEncode(estimator);
+
+  // encoded once into a buffer of the exact size
+  const Block& wire = data.wireEncode();
+  BOOST_CHECK_EQUAL(wire.size(), expectedSize);
+  BOOST_CHECK_EQUAL(wire.getBuffer()->size(), expectedSize);
+
+  // the same with an already encoded name
+  Data copy(data);
+  copy.setName(Name(Name("/encoded/name").wireEncode()));
+  ::ndn::EncodingEstimator copyEstimator;
+  BOOST_CHECK_EQUAL(copy.wireEncode().size(), copy.wireEncode(copyEstimator));
+  BOOST_CHECK_EQUAL(copy.wireEncode().getBuffer()->size(), copy.wireEncode().size());
+}
+
+BOOST_AUTO_TEST_CASE(ContentInWire)
+{
+  const Block& wire = data.wireEncode();
+
+  // the payload is held only by the wire
+  BOOST_CHECK(data.getContent().getBuffer() == wire.getBuffer());
+  BOOST_CHECK(data.getContent().wire() >= wire.wire());
+  BOOST_CHECK(data.getContent().wire() + data.getContent().size() <= wire.wire() + wire.size());
+}
+
+BOOST_AUTO_TEST_CASE(Unsigned)
+{
+  Data unsignedData(Name("/a"));
+  BOOST_CHECK_THROW(unsignedData.wireEncode(), Data::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/encoding/element-index.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::encoding::ElementIndex;
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxElementIndex, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(MatchesParse)
+{
+  Interest interest(Name("/prefix/a/b"));
+  interest.setNonce(42);
+  interest.setInterestLifetime(time::seconds(3));
+  interest.setFloodFlag(2);
+  interest.setDestinationFlag(7);
+
+  Block wire = interest.wireEncode();
+  ElementIndex index(wire);
+
+  Block parsed = wire;
+  parsed.parse();
+  BOOST_REQUIRE_EQUAL(index.size(), parsed.elements_size());
+  for (size_t i = 0; i < index.size(); ++i) {
+    BOOST_CHECK_EQUAL(index[i].type, parsed.elements()[i].type());
+    BOOST_CHECK(index.makeBlock(index[i]) == parsed.elements()[i]);
+  }
+
+  BOOST_CHECK(index.has(::ndn::tlv::Nonce));
+  BOOST_CHECK(!index.has(::ndn::tlv::Selectors));
+  BOOST_CHECK_EQUAL(index.readNonNegativeInteger(::ndn::tlv::InterestLifetime), 3000);
+  BOOST_CHECK_EQUAL(index.get(::ndn::tlv::Name).getBuffer(), wire.getBuffer());
+  BOOST_CHECK_THROW(index.get(::ndn::tlv::Selectors), Block::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  Block block(100);
+  for (uint64_t i = 0; i < ElementIndex::INLINE_CAPACITY * 2; ++i) {
+    block.push_back(::ndn::makeNonNegativeIntegerBlock(200 + i, i));
+  }
+  block.encode();
+
+  ElementIndex index(block);
+  BOOST_REQUIRE_EQUAL(index.size(), ElementIndex::INLINE_CAPACITY * 2);
+  for (uint64_t i = 0; i < index.size(); ++i) {
+    BOOST_CHECK_EQUAL(index[i].type, 200 + i);
+    BOOST_CHECK_EQUAL(index.readNonNegativeInteger(200 + i), i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  static const uint8_t WIRE[] = {0x05, 0x04, 0x07, 0x05, 0x08, 0x01};
+  Block block(WIRE, sizeof(WIRE));
+  BOOST_CHECK_THROW(ElementIndex index(block), ::ndn::tlv::Error);
+  BOOST_CHECK_THROW(Interest interest(block), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
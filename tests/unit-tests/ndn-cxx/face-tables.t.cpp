@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/detail/pending-interest-table.hpp>
+#include <ndn-cxx/detail/interest-filter-table.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::PendingInterest;
+using ::ndn::PendingInterestTable;
+using ::ndn::InterestFilterRecord;
+using ::ndn::InterestFilterTable;
+using ::ndn::InterestFilter;
+
+class FaceTablesFixture : public CleanupFixture
+{
+public:
+  FaceTablesFixture()
+    : scheduler(io)
+  {
+  }
+
+  PendingInterestTable::iterator
+  express(const shared_ptr<Interest>& interest, const std::string& tag)
+  {
+    return pit.insert(make_shared<PendingInterest>(interest,
+                                                   [this, tag] (const Interest&, Data&) {
+                                                     satisfied.push_back(tag);
+                                                   },
+                                                   nullptr, std::ref(scheduler)));
+  }
+
+  void
+  receive(const Data& data)
+  {
+    for (const auto& pendingInterest : pit.extractDataMatches(data)) {
+      pendingInterest->invokeDataCallback(data);
+    }
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+    return data;
+  }
+
+  shared_ptr<InterestFilterRecord>
+  makeFilter(const InterestFilter& filter, int id)
+  {
+    return make_shared<InterestFilterRecord>(filter,
+                                             [this, id] (const InterestFilter&, const Interest&) {
+                                               dispatched.push_back(id);
+                                             });
+  }
+
+  void
+  dispatch(const Interest& interest)
+  {
+    for (const auto& record : filters.findMatches(interest.getName())) {
+      record->invokeInterestCallback(interest);
+    }
+  }
+
+protected:
+  boost::asio::io_service io;
+  ::ndn::Scheduler scheduler;
+
+  PendingInterestTable pit;
+  std::vector<std::string> satisfied;
+
+  InterestFilterTable filters;
+  std::vector<int> dispatched;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxFaceTables, FaceTablesFixture)
+
+BOOST_AUTO_TEST_CASE(PendingInterestMatches)
+{
+  shared_ptr<Data> data = makeData("/a/b/c");
+
+  express(make_shared<Interest>(Name("/a/b/c")), "exact");
+  express(make_shared<Interest>(Name("/a")), "prefix");
+  express(make_shared<Interest>(Name("/a/b/d")), "other");
+  express(make_shared<Interest>(Name("/a/b/c")), "exact2");
+  auto withSelector = make_shared<Interest>(Name("/a/b"));
+  withSelector->setMaxSuffixComponents(1);
+  express(withSelector, "selector");
+  express(make_shared<Interest>(Name()), "root");
+  express(make_shared<Interest>(data->getFullName()), "digest");
+  express(make_shared<Interest>(makeData("/a/b/x")->getFullName()), "otherDigest");
+  BOOST_CHECK_EQUAL(pit.size(), 8);
+
+  receive(*data);
+
+  std::vector<std::string> expected = {"exact", "prefix", "exact2", "root", "digest"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(satisfied.begin(), satisfied.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(pit.size(), 3);
+
+  // satisfied entries are gone
+  satisfied.clear();
+  receive(*data);
+  BOOST_CHECK(satisfied.empty());
+}
+
+BOOST_AUTO_TEST_CASE(PendingInterestRemove)
+{
+  auto interest = make_shared<Interest>(Name("/a/b"));
+  express(interest, "removed");
+  auto entry = express(make_shared<Interest>(Name("/a/b")), "erased");
+  express(make_shared<Interest>(Name("/a/b")), "kept");
+
+  pit.remove(reinterpret_cast<const ::ndn::PendingInterestId*>(interest.get()));
+  pit.erase(entry);
+  BOOST_CHECK_EQUAL(pit.size(), 1);
+
+  bool isEmpty = false;
+  pit.onEmpty.connect([&isEmpty] { isEmpty = true; });
+
+  receive(*makeData("/a/b/c"));
+  BOOST_REQUIRE_EQUAL(satisfied.size(), 1);
+  BOOST_CHECK_EQUAL(satisfied[0], "kept");
+  BOOST_CHECK(pit.empty());
+  BOOST_CHECK(isEmpty);
+}
+
+BOOST_AUTO_TEST_CASE(ManyPendingInterests)
+{
+  for (uint64_t segment = 0; segment < 10000; segment++) {
+    express(make_shared<Interest>(Name("/segments").appendSegment(segment)), "segment");
+  }
+
+  for (uint64_t segment = 0; segment < 10000; segment++) {
+    receive(*makeData(Name("/segments").appendSegment(segment)));
+  }
+
+  BOOST_CHECK_EQUAL(satisfied.size(), 10000);
+  BOOST_CHECK(pit.empty());
+}
+
+BOOST_AUTO_TEST_CASE(InterestFilterDispatch)
+{
+  auto filter1 = makeFilter(InterestFilter("/a/b"), 1);
+  auto filter2 = makeFilter(InterestFilter("/"), 2);
+  auto filter3 = makeFilter(InterestFilter("/a", "<b><>"), 3);
+  auto filter4 = makeFilter(InterestFilter("/a/c"), 4);
+  auto filter5 = makeFilter(InterestFilter("/a"), 5);
+  auto filter6 = makeFilter(InterestFilter("/a", "<c>"), 6);
+  for (const auto& filter : {filter1, filter2, filter3, filter4, filter5, filter6}) {
+    filters.push_back(filter);
+  }
+
+  Interest interest(Name("/a/b/c"));
+  dispatch(interest);
+  std::vector<int> expected = {1, 2, 3, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(dispatched.begin(), dispatched.end(),
+                                expected.begin(), expected.end());
+
+  filters.erase(reinterpret_cast<const ::ndn::InterestFilterId*>(filter1.get()));
+  filters.remove(filter5);
+  filters.remove(filter5);
+  BOOST_CHECK_EQUAL(filters.size(), 4);
+
+  dispatched.clear();
+  dispatch(interest);
+  expected = {2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(dispatched.begin(), dispatched.end(),
+                                expected.begin(), expected.end());
+
+  for (const auto& filter : {filter2, filter3, filter4, filter6}) {
+    filters.remove(filter);
+  }
+  BOOST_CHECK(filters.empty());
+  BOOST_CHECK(filters.findMatches(interest.getName()).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+namespace tlv = ::ndn::tlv;
+
+class InterestDecodeFixture : public CleanupFixture
+{
+public:
+  InterestDecodeFixture()
+    : interest(Name("/prefix/a/b"))
+  {
+    interest.setNonce(42);
+    interest.setInterestLifetime(time::seconds(3));
+    interest.setMustBeFresh(true);
+    interest.setFloodFlag(2);
+    interest.setDestinationFlag(7);
+  }
+
+  /**
+   * \brief Build Interest wire from elements of the encoded interest in the specified order
+   */
+  Block
+  makeWire(std::initializer_list<uint32_t> types)
+  {
+    const Block& wire = interest.wireEncode();
+    wire.parse();
+
+    Block block(tlv::Interest);
+    for (uint32_t type : types) {
+      block.push_back(wire.get(type));
+    }
+    block.encode();
+    return block;
+  }
+
+  void
+  checkDecoded(const Interest& decoded)
+  {
+    BOOST_CHECK_EQUAL(decoded.getName(), interest.getName());
+    BOOST_CHECK_EQUAL(decoded.getNonce(), 42);
+    BOOST_CHECK_EQUAL(decoded.getInterestLifetime(), time::seconds(3));
+    BOOST_CHECK_EQUAL(decoded.getMustBeFresh(), true);
+    BOOST_CHECK_EQUAL(decoded.getFloodFlag(), 2);
+    BOOST_CHECK_EQUAL(decoded.getDestinationFlag(), 7);
+  }
+
+public:
+  Interest interest;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxInterestDecode, InterestDecodeFixture)
+
+BOOST_AUTO_TEST_CASE(WireOrder)
+{
+  Interest decoded(Block(interest.wireEncode().wire(), interest.wireEncode().size()));
+  checkDecoded(decoded);
+  BOOST_CHECK(decoded.wireEncode() == interest.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(OtherOrder)
+{
+  Block wire = makeWire({tlv::Name, tlv::Selectors, tlv::Nonce, tlv::InterestLifetime,
+                         tlv::DestinationFlag, tlv::FloodFlag});
+  wire.push_back(::ndn::makeNonNegativeIntegerBlock(200, 1)); // unknown elements are ignored
+  wire.encode();
+
+  checkDecoded(Interest(wire));
+}
+
+BOOST_AUTO_TEST_CASE(MissingElement)
+{
+  BOOST_CHECK_THROW(Interest(makeWire({tlv::FloodFlag, tlv::DestinationFlag, tlv::Name})),
+                    Block::Error);
+  BOOST_CHECK_THROW(Interest(makeWire({tlv::FloodFlag, tlv::Name, tlv::Nonce})), Block::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxInterestEncode, InterestDecodeFixture)
+
+BOOST_AUTO_TEST_CASE(InPlaceUpdate)
+{
+  Block wire = interest.wireEncode();
+
+  interest.setNonce(43); // modified in place, the wire is not re-encoded
+  BOOST_CHECK_EQUAL(interest.wireEncode().wire(), wire.wire());
+
+  Interest decoded(Block(wire.wire(), wire.size()));
+  BOOST_CHECK_EQUAL(decoded.getNonce(), 43);
+  BOOST_CHECK_EQUAL(decoded.getName(), interest.getName());
+
+  interest.setDestinationFlag(8);
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getDestinationFlag(), 8);
+  BOOST_CHECK_EQUAL(Interest(interest.wireEncode()).getNonce(), 43);
+}
+
+BOOST_AUTO_TEST_CASE(ExactSize)
+{
+  Name longName("/prefix");
+  longName.append(std::string(300, 'x')); // multi-octet TLV lengths
+
+  std::vector<Interest> interests;
+  interests.push_back(interest);
+  interests.push_back(Interest(Name("/a")));
+  interests.back().setInterestLifetime(time::milliseconds(253)); // 1-octet NonNegativeInteger
+  interests.push_back(Interest(Name(Name("/encoded/name").wireEncode())));
+  interests.push_back(Interest(longName));
+  interests.back().setInterestLifetime(time::hours(100));
+  interests.back().setNonce(0xFFFFFFFF);
+
+  for (const Interest& i : interests) {
+    ::ndn::EncodingEstimator estimator;
+    size_t expectedSize = i.wireEncode(estimator);
+
+    // encoded once into a buffer of the exact size
+    const Block& wire = i.wireEncode();
+    BOOST_CHECK_EQUAL(wire.size(), expectedSize);
+    BOOST_CHECK_EQUAL(wire.getBuffer()->size(), expectedSize);
+
+    Interest decoded(Block(wire.wire(), wire.size()));
+    BOOST_CHECK_EQUAL(decoded.getName(), i.getName());
+    BOOST_CHECK_EQUAL(decoded.getNonce(), i.getNonce());
+    BOOST_CHECK_EQUAL(decoded.getMustBeFresh(), i.getMustBeFresh());
+    BOOST_CHECK(decoded.wireEncode() == wire);
+  }
+
+  Interest decoded(interests.back().wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getInterestLifetime(), time::hours(100));
+}
+
+BOOST_AUTO_TEST_CASE(ReusableBuffer)
+{
+  Block block;
+  {
+    ::ndn::EncodingBuffer encoder(::ndn::encoding::ReusableBufferTag{});
+    interest.wireEncode(encoder);
+    block = encoder.block();
+    BOOST_CHECK(block.getBuffer() != encoder.getBuffer());
+    BOOST_CHECK_EQUAL(block.getBuffer()->size(), block.size());
+  }
+
+  // the buffer is back in the pool, reusing it must not affect the block
+  ::ndn::EncodingBuffer encoder(::ndn::encoding::ReusableBufferTag{});
+  Interest(Name("/other")).setNonce(1).wireEncode(encoder);
+
+  BOOST_CHECK(block == interest.wireEncode());
+  checkDecoded(Interest(block));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-name-builder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnNameBuilder, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SameAsAppend)
+{
+  Name prefix("/prefix");
+  NameBuilder builder;
+
+  const uint64_t numbers[] = {0, 1, 255, 256, 70000, 5000000000ULL};
+  for (uint64_t number : numbers) {
+    for (uint64_t seq : numbers) {
+      builder.SetPrefix(prefix);
+      Name name = builder.AppendNumber(number).AppendSequenceNumber(seq).Build();
+
+      Name expected = prefix;
+      expected.appendNumber(number).appendSequenceNumber(seq);
+      BOOST_CHECK_EQUAL(name, expected);
+      BOOST_CHECK(name.wireEncode() == expected.wireEncode());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SingleBuffer)
+{
+  NameBuilder builder;
+  builder.SetPrefix(Name("/prefix/a"));
+  Name name = builder.AppendNumber(1).AppendSequenceNumber(2).Build();
+
+  BOOST_REQUIRE_EQUAL(name.size(), 4);
+  for (size_t i = 0; i < name.size(); i++) {
+    BOOST_CHECK_EQUAL(name.get(i).getBuffer(), name.wireEncode().getBuffer());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ChangePrefix)
+{
+  NameBuilder builder;
+  BOOST_CHECK_EQUAL(builder.Build(), Name());
+
+  Name prefix("/a");
+  builder.SetPrefix(prefix);
+  BOOST_CHECK_EQUAL(builder.AppendSequenceNumber(1).Build(), Name("/a").appendSequenceNumber(1));
+  BOOST_CHECK_EQUAL(builder.Build(), prefix);
+
+  prefix.append("b");
+  builder.SetPrefix(prefix);
+  BOOST_CHECK_EQUAL(builder.AppendNumber(2).Build(), Name("/a/b").appendNumber(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-outstanding-request-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnOutstandingRequestTable, CleanupFixture)
+
+typedef OutstandingRequestTable::Key Key;
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  OutstandingRequestTable table(MilliSeconds(50));
+
+  // same sequence number under different prefixes must not alias
+  for (uint32_t prefix = 0; prefix < 100; prefix++) {
+    for (uint32_t seq = 0; seq < 100; seq++) {
+      table.Send(prefix, seq, MilliSeconds(prefix));
+    }
+  }
+  table.Send(OutstandingRequestTable::NO_PREFIX, 5, Seconds(1));
+  BOOST_CHECK_EQUAL(table.GetSize(), 10001);
+
+  const OutstandingRequestTable::Entry* entry = table.Find(42, 5);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->firstSent, MilliSeconds(42));
+  BOOST_CHECK_EQUAL(entry->retxCount, 1);
+
+  table.Send(42, 5, MilliSeconds(500));
+  entry = table.Find(42, 5);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->firstSent, MilliSeconds(42));
+  BOOST_CHECK_EQUAL(entry->lastSent, MilliSeconds(500));
+  BOOST_CHECK_EQUAL(entry->retxCount, 2);
+
+  BOOST_CHECK_EQUAL(table.Find(OutstandingRequestTable::NO_PREFIX, 5)->firstSent, Seconds(1));
+  BOOST_CHECK(table.Find(100, 5) == nullptr);
+
+  // erase every other entry, the rest must stay reachable
+  for (uint32_t prefix = 0; prefix < 100; prefix++) {
+    for (uint32_t seq = 0; seq < 100; seq += 2) {
+      BOOST_CHECK(table.Erase(prefix, seq));
+    }
+  }
+  BOOST_CHECK(!table.Erase(0, 0));
+  BOOST_CHECK_EQUAL(table.GetSize(), 5001);
+
+  for (uint32_t prefix = 0; prefix < 100; prefix++) {
+    for (uint32_t seq = 0; seq < 100; seq++) {
+      BOOST_CHECK_EQUAL(table.Find(prefix, seq) != nullptr, seq % 2 == 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  OutstandingRequestTable table(MilliSeconds(50));
+  std::vector<Key> expired;
+
+  table.Send(1, 10, MilliSeconds(10));
+  table.Send(2, 10, MilliSeconds(20));
+  table.Send(1, 11, MilliSeconds(120));
+  table.Send(1, 12, MilliSeconds(130));
+  BOOST_CHECK_EQUAL(table.GetNArmed(), 4);
+
+  table.Expire(MilliSeconds(5), expired);
+  BOOST_CHECK_EQUAL(expired.size(), 0);
+
+  table.Expire(MilliSeconds(120), expired);
+  BOOST_REQUIRE_EQUAL(expired.size(), 3);
+  BOOST_CHECK(expired[0] == Key(1, 10));
+  BOOST_CHECK(expired[1] == Key(2, 10));
+  BOOST_CHECK(expired[2] == Key(1, 11));
+
+  // expired requests keep their delay information
+  BOOST_CHECK_EQUAL(table.GetNArmed(), 1);
+  BOOST_CHECK_EQUAL(table.GetSize(), 4);
+
+  // retransmission re-arms the request
+  table.Send(1, 10, MilliSeconds(200));
+  BOOST_CHECK(table.Erase(1, 12));
+
+  expired.clear();
+  table.Expire(MilliSeconds(199), expired);
+  BOOST_CHECK_EQUAL(expired.size(), 0);
+
+  table.Expire(MilliSeconds(200), expired);
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK(expired[0] == Key(1, 10));
+  BOOST_CHECK_EQUAL(table.GetNArmed(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExpireAfterWheelRound)
+{
+  OutstandingRequestTable table(MilliSeconds(1));
+  std::vector<Key> expired;
+
+  // requests that share buckets of the wheel, but are sent in different rounds
+  for (uint32_t seq = 0; seq < 5000; seq++) {
+    table.Send(OutstandingRequestTable::NO_PREFIX, seq, MilliSeconds(seq));
+  }
+
+  table.Expire(MilliSeconds(999), expired);
+  BOOST_REQUIRE_EQUAL(expired.size(), 1000);
+  BOOST_CHECK_EQUAL(expired.back().second, 999);
+
+  // deadline far ahead of the previous one
+  expired.clear();
+  table.Expire(Seconds(10), expired);
+  BOOST_REQUIRE_EQUAL(expired.size(), 4000);
+  for (uint32_t i = 0; i < expired.size(); i++) {
+    BOOST_CHECK_EQUAL(expired[i].second, i + 1000);
+  }
+
+  // change of the tick keeps armed requests
+  table.Send(OutstandingRequestTable::NO_PREFIX, 0, Seconds(11));
+  table.SetTick(MilliSeconds(50));
+  expired.clear();
+  table.Expire(Seconds(11), expired);
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
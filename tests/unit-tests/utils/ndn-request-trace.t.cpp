@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+#include "apps/ndn-trace-replay.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_REQUESTS =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "requests.bin";
+
+class RequestTraceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RequestTraceFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~RequestTraceFixture()
+  {
+    boost::filesystem::remove(TEST_REQUESTS);
+  }
+
+  void
+  writeTrace(std::initializer_list<RequestTrace::Record> records)
+  {
+    RequestTraceWriter writer;
+    BOOST_REQUIRE(writer.Open(TEST_REQUESTS.string()));
+    for (const RequestTrace::Record& record : records) {
+      writer.Write(record);
+    }
+    writer.Close();
+  }
+
+  void
+  onInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    sentInterests.push_back(std::make_tuple(Simulator::Now(), interest->getName()));
+  }
+
+public:
+  std::vector<std::tuple<Time, Name>> sentInterests;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRequestTrace, RequestTraceFixture)
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  writeTrace({{1000, 1, 2, 3, 4, 5, 0},
+              {2000, 6, 7, 8, 9, 10, 0}});
+
+  RequestTrace trace;
+  BOOST_REQUIRE(trace.Open(TEST_REQUESTS.string()));
+  BOOST_REQUIRE_EQUAL(trace.GetNRecords(), 2);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).time, 1000);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).consumerNode, 1);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).producer, 2);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).content, 3);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).nChunks, 4);
+  BOOST_CHECK_EQUAL(trace.GetRecord(0).scope, 5);
+  BOOST_CHECK_EQUAL(trace.GetRecord(1).time, 2000);
+  BOOST_CHECK_EQUAL(trace.GetRecord(1).scope, 10);
+  trace.Close();
+
+  // truncated file is rejected
+  boost::filesystem::resize_file(TEST_REQUESTS, boost::filesystem::file_size(TEST_REQUESTS) - 1);
+  BOOST_CHECK(!trace.Open(TEST_REQUESTS.string()));
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  createTopology({
+      {"1", "2"}
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerSit", {{"Prefix", "/prefix"}}, "0s", "100s"}
+    });
+
+  Ptr<Node> node1 = getNode("1");
+  Ptr<Node> node2 = getNode("2");
+
+  // third request comes from a node without a consumer
+  writeTrace({{Seconds(1).GetNanoSeconds(), node1->GetId(), 0, 10, 3, 2, 0},
+              {Seconds(1).GetNanoSeconds(), node1->GetId(), 1, 20, 1, 0, 0},
+              {Seconds(2).GetNanoSeconds(), node2->GetId(), 0, 30, 1, 0, 0}});
+
+  ApplicationContainer consumers(node1->GetApplication(0));
+  consumers.Get(0)->TraceConnectWithoutContext("TransmittedInterests",
+                                               MakeCallback(&RequestTraceFixture::onInterest,
+                                                            this));
+
+  Ptr<TraceReplay> replay = CreateObject<TraceReplay>();
+  replay->SetAttribute("TraceFile", StringValue(TEST_REQUESTS.string()));
+  replay->SetAttribute("ChunkInterval", StringValue("10ms"));
+  replay->SetConsumers(consumers);
+  node1->AddApplication(replay);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(replay->GetNReplayed(), 3);
+  BOOST_REQUIRE_EQUAL(sentInterests.size(), 4);
+
+  BOOST_CHECK_EQUAL(std::get<0>(sentInterests[0]), Seconds(1));
+  BOOST_CHECK_EQUAL(std::get<1>(sentInterests[0]),
+                    Name("/prefix").appendNumber(0).appendSequenceNumber(10));
+  BOOST_CHECK_EQUAL(std::get<0>(sentInterests[1]), Seconds(1));
+  BOOST_CHECK_EQUAL(std::get<1>(sentInterests[1]),
+                    Name("/prefix").appendNumber(1).appendSequenceNumber(20));
+  BOOST_CHECK_EQUAL(std::get<0>(sentInterests[2]), Seconds(1) + MilliSeconds(10));
+  BOOST_CHECK_EQUAL(std::get<1>(sentInterests[2]),
+                    Name("/prefix").appendNumber(0).appendSequenceNumber(11));
+  BOOST_CHECK_EQUAL(std::get<0>(sentInterests[3]), Seconds(1) + MilliSeconds(20));
+  BOOST_CHECK_EQUAL(std::get<1>(sentInterests[3]),
+                    Name("/prefix").appendNumber(0).appendSequenceNumber(12));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
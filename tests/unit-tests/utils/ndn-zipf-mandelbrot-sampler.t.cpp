@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-mandelbrot-sampler.hpp"
+
+#include "ns3/random-variable-stream.h"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnZipfMandelbrotSampler, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SharedTable)
+{
+  shared_ptr<const ZipfMandelbrotSampler> a = ZipfMandelbrotSampler::Get(1000, 0.7, 0.7);
+  shared_ptr<const ZipfMandelbrotSampler> b = ZipfMandelbrotSampler::Get(1000, 0.7, 0.7);
+  shared_ptr<const ZipfMandelbrotSampler> c = ZipfMandelbrotSampler::Get(1000, 0.0, 0.7);
+
+  BOOST_CHECK_EQUAL(a, b);
+  BOOST_CHECK_NE(a, c);
+  BOOST_CHECK_EQUAL(a->GetN(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(ReleasedTable)
+{
+  weak_ptr<const ZipfMandelbrotSampler> released = ZipfMandelbrotSampler::Get(500, 0.7, 0.7);
+  BOOST_CHECK(released.expired());
+
+  // expired registry entries are pruned and a fresh table is built on the next request
+  shared_ptr<const ZipfMandelbrotSampler> a = ZipfMandelbrotSampler::Get(500, 0.7, 0.7);
+  shared_ptr<const ZipfMandelbrotSampler> b = ZipfMandelbrotSampler::Get(10, 0.7, 0.7);
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_CHECK_EQUAL(a->GetN(), 500);
+  BOOST_CHECK_EQUAL(b->GetN(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(SingleContent)
+{
+  ZipfMandelbrotSampler sampler(1, 0.7, 0.7);
+
+  BOOST_CHECK_CLOSE(sampler.GetProbability(1), 1.0, 1e-9);
+  BOOST_CHECK_EQUAL(sampler.Sample(0.0), 1);
+  BOOST_CHECK_EQUAL(sampler.Sample(0.5), 1);
+  BOOST_CHECK_EQUAL(sampler.Sample(0.9999999999), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Probabilities)
+{
+  const uint32_t n = 100;
+  const double q = 0.7;
+  const double s = 0.7;
+  ZipfMandelbrotSampler sampler(n, q, s);
+
+  double sum = 0.0;
+  for (uint32_t k = 1; k <= n; k++) {
+    sum += 1.0 / std::pow(k + q, s);
+  }
+
+  // alias table must represent exactly the Zipf-Mandelbrot probabilities
+  for (uint32_t k = 1; k <= n; k++) {
+    BOOST_CHECK_CLOSE(sampler.GetProbability(k), 1.0 / std::pow(k + q, s) / sum, 1e-9);
+  }
+
+  BOOST_CHECK_EQUAL(sampler.Sample(0.0), 1);
+  BOOST_CHECK_LE(sampler.Sample(0.9999999999), n);
+}
+
+BOOST_AUTO_TEST_CASE(Fidelity)
+{
+  const uint32_t n = 100;
+  const double q = 0.0;
+  const double s = 0.9;
+  const uint32_t nDraws = 1000000;
+  ZipfMandelbrotSampler sampler(n, q, s);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+  rng->SetStream(1);
+
+  std::vector<uint32_t> counts(n + 1, 0);
+  for (uint32_t i = 0; i < nDraws; i++) {
+    uint32_t k = sampler.Sample(rng->GetValue());
+    BOOST_REQUIRE(k >= 1 && k <= n);
+    counts[k]++;
+  }
+
+  double sum = 0.0;
+  for (uint32_t k = 1; k <= n; k++) {
+    sum += 1.0 / std::pow(k + q, s);
+  }
+
+  double chiSquare = 0.0;
+  for (uint32_t k = 1; k <= n; k++) {
+    double expected = nDraws / std::pow(k + q, s) / sum;
+    chiSquare += (counts[k] - expected) * (counts[k] - expected) / expected;
+  }
+
+  // critical value of chi-square distribution with 99 degrees of freedom for p = 0.001
+  BOOST_CHECK_LT(chiSquare, 148.23);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
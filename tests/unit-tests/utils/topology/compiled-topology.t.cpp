@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/compiled-topology.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+#include "utils/topology/rocketfuel-map-reader.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/mobility-model.h"
+#include "ns3/names.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPOLOGY_DIR =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "compiled-topology";
+
+class CompiledTopologyFixture : public CleanupFixture
+{
+public:
+  CompiledTopologyFixture()
+  {
+    boost::filesystem::create_directories(TEST_TOPOLOGY_DIR);
+    nodes.Create(2);
+  }
+
+  ~CompiledTopologyFixture()
+  {
+    boost::filesystem::remove_all(TEST_TOPOLOGY_DIR);
+  }
+
+  size_t
+  countFiles() const
+  {
+    return std::distance(boost::filesystem::directory_iterator(TEST_TOPOLOGY_DIR),
+                         boost::filesystem::directory_iterator());
+  }
+
+  /**
+   * \brief Describe nodes (name, system ID, position, role) and links (ends and attributes)
+   *        read by the reader, in the order they were created
+   */
+  template<class Reader>
+  std::vector<std::string>
+  describe(const Reader& reader, const std::map<uint32_t, std::string>& roles = {}) const
+  {
+    std::vector<std::string> description;
+
+    NodeContainer readNodes = reader.GetNodes();
+    for (NodeContainer::Iterator node = readNodes.Begin(); node != readNodes.End(); node++) {
+      std::ostringstream os;
+      os << "node " << Names::FindName(*node) << " " << (*node)->GetSystemId();
+      Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel>();
+      if (mobility != 0) {
+        os << " " << mobility->GetPosition();
+      }
+      auto role = roles.find((*node)->GetId());
+      if (role != roles.end()) {
+        os << " " << role->second;
+      }
+      description.push_back(os.str());
+    }
+
+    for (const TopologyReader::Link& link : reader.GetLinks()) {
+      std::ostringstream os;
+      os << "link " << link.GetFromNodeName() << " " << link.GetToNodeName();
+      for (TopologyReader::Link::ConstAttributesIterator attr = link.AttributesBegin();
+           attr != link.AttributesEnd(); attr++) {
+        os << " " << attr->first << "=" << attr->second;
+      }
+      description.push_back(os.str());
+    }
+
+    return description;
+  }
+
+  std::map<uint32_t, std::string>
+  getRoles(const RocketfuelMapReader& reader) const
+  {
+    std::map<uint32_t, std::string> roles;
+    for (uint32_t i = 0; i < reader.GetBackboneRouters().GetN(); i++) {
+      roles[reader.GetBackboneRouters().Get(i)->GetId()] = "backbone";
+    }
+    for (uint32_t i = 0; i < reader.GetGatewayRouters().GetN(); i++) {
+      roles[reader.GetGatewayRouters().Get(i)->GetId()] = "gateway";
+    }
+    for (uint32_t i = 0; i < reader.GetCustomerRouters().GetN(); i++) {
+      roles[reader.GetCustomerRouters().Get(i)->GetId()] = "customer";
+    }
+    return roles;
+  }
+
+  std::string
+  writeAnnotatedTopology() const
+  {
+    std::string file = (TEST_TOPOLOGY_DIR / "topo.txt").string();
+    std::ofstream os(file.c_str());
+    os << "router\n\n"
+       << "#node city  y x mpi-partition\n"
+       << "A  NA  1 1 0\n"
+       << "B  NA  80  -40 0\n"
+       << "C  NA  80  40  0\n\n"
+       << "link\n\n"
+       << "# from  to  capacity  metric  delay queue\n"
+       << "A       B   10Mbps    100 1ms 100\n"
+       << "A       C   10Mbps    50  2ms\n"
+       << "B       C   1Mbps     1 1ms 10\n";
+    return file;
+  }
+
+  std::string
+  writeRocketfuelMap() const
+  {
+    // 4 backbone routers in a ring, 4 gateways attached to 2 backbones each, and 8 clients
+    std::string file = (TEST_TOPOLOGY_DIR / "map.cch").string();
+    std::ofstream os(file.c_str());
+    for (int i = 1; i <= 4; i++) {
+      os << i << " @Test bb (4) -> <" << (i % 4 + 1) << "> <" << ((i + 2) % 4 + 1) << "> <"
+         << (100 + i) << "> <" << (100 + i % 4 + 1) << "> =r" << i << ".test r0\n";
+    }
+    for (int i = 1; i <= 4; i++) {
+      os << (100 + i) << " @Test (4) -> <" << i << "> <" << ((i + 2) % 4 + 1) << "> <"
+         << (200 + 2 * i - 1) << "> <" << (200 + 2 * i) << "> =r" << (100 + i) << ".test r0\n";
+    }
+    for (int i = 1; i <= 8; i++) {
+      os << (200 + i) << " @Test (1) -> <" << (100 + (i + 1) / 2) << "> =r" << (200 + i)
+         << ".test r0\n";
+    }
+    return file;
+  }
+
+  RocketfuelParams
+  getRocketfuelParams() const
+  {
+    RocketfuelParams params;
+    params.averageRtt = 2.0;
+    params.clientNodeDegrees = 2;
+    params.minb2bDelay = "1ms";
+    params.minb2bBandwidth = "10Mbps";
+    params.maxb2bDelay = "6ms";
+    params.maxb2bBandwidth = "100Mbps";
+    params.minb2gDelay = "1ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.maxb2gDelay = "2ms";
+    params.maxb2gBandwidth = "50Mbps";
+    params.ming2cDelay = "1ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.maxg2cDelay = "3ms";
+    params.maxg2cBandwidth = "10Mbps";
+    return params;
+  }
+
+  /**
+   * \brief Overwrite 32-bit value at \p offset of the file
+   */
+  void
+  corrupt(const std::string& file, size_t offset, uint32_t value) const
+  {
+    std::fstream fs(file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    fs.seekp(offset);
+    fs.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+public:
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyCompiledTopology, CompiledTopologyFixture)
+
+BOOST_AUTO_TEST_CASE(Write)
+{
+  std::string file = (TEST_TOPOLOGY_DIR / "topo.ndntopo").string();
+  CompiledTopology::Write(file, 42, nodes, {}, {});
+  CompiledTopology::Write(file, 42, nodes, {}, {}); // replaces the existing file
+
+  CompiledTopology topology;
+  BOOST_REQUIRE(topology.Open(file));
+  BOOST_CHECK_EQUAL(topology.GetHeader().fingerprint, 42);
+  BOOST_CHECK_EQUAL(topology.GetHeader().nNodes, 2);
+
+  // temporary files have been renamed into place
+  BOOST_CHECK_EQUAL(countFiles(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RenameFailure)
+{
+  // non-empty directory in place of the output file cannot be replaced
+  boost::filesystem::path file = TEST_TOPOLOGY_DIR / "topo.ndntopo";
+  boost::filesystem::create_directories(file / "occupied");
+
+  CompiledTopology::Write(file.string(), 42, nodes, {}, {});
+
+  BOOST_CHECK(boost::filesystem::is_directory(file));
+  BOOST_CHECK_EQUAL(countFiles(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedRoundTrip)
+{
+  std::string cache = (TEST_TOPOLOGY_DIR / "topo.ndntopo").string();
+  std::string text = writeAnnotatedTopology();
+
+  // the first run parses the text file and compiles it
+  AnnotatedTopologyReader textReader;
+  textReader.SetFileName(text);
+  textReader.ReadCached(cache);
+  std::vector<std::string> expected = describe(textReader);
+  BOOST_REQUIRE_EQUAL(expected.size(), 6);
+
+  Names::Clear();
+  AnnotatedTopologyReader compiledReader;
+  compiledReader.ReadCompiled(cache);
+  std::vector<std::string> loaded = describe(compiledReader);
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+
+  Names::Clear();
+  AnnotatedTopologyReader cachedReader;
+  cachedReader.SetFileName(text);
+  cachedReader.ReadCached(cache);
+  loaded = describe(cachedReader);
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(RocketfuelRoundTrip)
+{
+  std::string cache = (TEST_TOPOLOGY_DIR / "map.ndntopo").string();
+  std::string map = writeRocketfuelMap();
+
+  // sampled link parameters and node roles come from the cache
+  RocketfuelMapReader textReader("", 10);
+  textReader.SetFileName(map);
+  textReader.ReadCached(cache, getRocketfuelParams());
+  std::vector<std::string> expected = describe(textReader, getRoles(textReader));
+  BOOST_REQUIRE_GT(textReader.GetBackboneRouters().GetN(), 0);
+  BOOST_REQUIRE_GT(textReader.GetCustomerRouters().GetN(), 0);
+
+  Names::Clear();
+  RocketfuelMapReader compiledReader("", 10);
+  compiledReader.ReadCompiled(cache);
+  std::vector<std::string> loaded = describe(compiledReader, getRoles(compiledReader));
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(compiledReader.GetBackboneRouters().GetN(),
+                    textReader.GetBackboneRouters().GetN());
+  BOOST_CHECK_EQUAL(compiledReader.GetGatewayRouters().GetN(),
+                    textReader.GetGatewayRouters().GetN());
+  BOOST_CHECK_EQUAL(compiledReader.GetCustomerRouters().GetN(),
+                    textReader.GetCustomerRouters().GetN());
+}
+
+BOOST_AUTO_TEST_CASE(CorruptedFile)
+{
+  std::string cache = (TEST_TOPOLOGY_DIR / "topo.ndntopo").string();
+  std::string text = writeAnnotatedTopology();
+
+  AnnotatedTopologyReader textReader;
+  textReader.SetFileName(text);
+  textReader.ReadCached(cache);
+  std::vector<std::string> expected = describe(textReader);
+
+  CompiledTopology topology;
+  BOOST_REQUIRE(topology.Open(cache));
+  CompiledTopology::Header header = topology.GetHeader();
+  topology.Close();
+
+  size_t linksOffset = sizeof(CompiledTopology::Header)
+                       + header.nNodes * sizeof(CompiledTopology::NodeRecord);
+  size_t attributesOffset = linksOffset + header.nLinks * sizeof(CompiledTopology::LinkRecord);
+
+  // every kind of dangling reference is rejected
+  std::vector<std::pair<size_t, uint32_t>> corruptions = {
+    {sizeof(CompiledTopology::Header) + offsetof(CompiledTopology::NodeRecord, name),
+     header.stringsSize},
+    {linksOffset + offsetof(CompiledTopology::LinkRecord, toNode), header.nNodes},
+    {linksOffset + offsetof(CompiledTopology::LinkRecord, nAttributes), header.nAttributes + 1},
+    {attributesOffset + offsetof(CompiledTopology::AttributeRecord, value), 0xFFFFFFFF},
+  };
+  for (const auto& corruption : corruptions) {
+    boost::filesystem::path copy = TEST_TOPOLOGY_DIR / "corrupted.ndntopo";
+    boost::filesystem::remove(copy);
+    boost::filesystem::copy_file(cache, copy);
+    corrupt(copy.string(), corruption.first, corruption.second);
+    BOOST_CHECK(!topology.Open(copy.string()));
+  }
+
+  // the reader falls back to the text file and replaces the cache
+  corrupt(cache, linksOffset + offsetof(CompiledTopology::LinkRecord, fromNode), 0xFFFFFFFF);
+  Names::Clear();
+  AnnotatedTopologyReader cachedReader;
+  cachedReader.SetFileName(text);
+  cachedReader.ReadCached(cache);
+  std::vector<std::string> loaded = describe(cachedReader);
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+  BOOST_CHECK(topology.Open(cache));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-trace-reader.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
@@ -28,6 +29,8 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace.ndntrace";
 
 class AppDelayTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -68,6 +71,7 @@ public:
   ~AppDelayTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     AppDelayTracer::Destroy(); // additional cleanup
   }
 };
@@ -97,6 +101,78 @@ BOOST_AUTO_TEST_CASE(InstallAll)
     "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  AppDelayTracer::InstallAll(TEST_BINARY_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::stringstream buffer;
+  BOOST_CHECK(TraceReader::ConvertToCsv(TEST_BINARY_TRACE.string(), buffer, '\t'));
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417424	1	0	0	LastDelay	0.0417424	41742.4	1	2\n"
+    "0.0417424	1	0	0	FullDelay	0.0417424	41742.4	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02087	2	0	1	LastDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllHistograms)
+{
+  AppDelayTracer::InstallAllHistograms(TEST_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force histograms to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	Min	Mean	P50	P90	P99	P99.9	Max\n"
+    "4	1	0	LastDelay	1	41742	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	FullDelay	1	41742	41742	41742	41742	41742	41742	41742\n"
+    "4	1	0	HopCount	1	2	2	2	2	2	2	2\n"
+    "4	2	0	LastDelay	2	0	10435.5	0	20871	20871	20871	20871\n"
+    "4	2	0	FullDelay	2	0	10435.5	0	20871	20871	20871	20871\n"
+    "4	2	0	HopCount	2	0	0.5	0	1	1	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallHistogramsPeriodic)
+{
+  AppDelayTracer::InstallHistograms(NodeContainer::GetGlobal(), TEST_TRACE.string(),
+                                    Seconds(1.5), AppDelayTracer::PER_NODE);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force histograms to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	Min	Mean	P50	P90	P99	P99.9	Max\n"
+    "1.5	1	-1	LastDelay	1	41742	41742	41742	41742	41742	41742	41742\n"
+    "1.5	1	-1	FullDelay	1	41742	41742	41742	41742	41742	41742	41742\n"
+    "1.5	1	-1	HopCount	1	2	2	2	2	2	2	2\n"
+    "3	2	-1	LastDelay	1	0	0	0	0	0	0	0\n"
+    "3	2	-1	FullDelay	1	0	0	0	0	0	0	0\n"
+    "3	2	-1	HopCount	1	0	0	0	0	0	0	0\n"
+    "4	2	-1	LastDelay	1	20871	20871	20871	20871	20871	20871	20871\n"
+    "4	2	-1	FullDelay	1	20871	20871	20871	20871	20871	20871	20871\n"
+    "4	2	-1	HopCount	1	1	1	1	1	1	1	1\n");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 {
   NodeContainer nodes;
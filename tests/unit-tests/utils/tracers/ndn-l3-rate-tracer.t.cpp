@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L3RateTracerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"}, // 10 Interests, all satisfied within the first period
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  /**
+   * @brief Find row of the trace and return its fields
+   */
+  static std::vector<std::string>
+  findRow(const std::string& trace, const std::string& faceDescr, const std::string& type)
+  {
+    std::vector<std::string> lines;
+    boost::split(lines, trace, boost::is_any_of("\n"));
+    for (const auto& line : lines) {
+      std::vector<std::string> fields;
+      boost::split(fields, line, boost::is_any_of("\t"));
+      if (fields.size() == 9 && fields[3] == faceDescr && fields[4] == type) {
+        return fields;
+      }
+    }
+    return {};
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3RateTracer, L3RateTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // Time Node FaceId FaceDescr Type Packets Kilobytes PacketRaw KilobytesRaw
+  auto outInterests = findRow(output->str(), "netDeviceFace://", "OutInterests");
+  BOOST_REQUIRE_EQUAL(outInterests.size(), 9);
+  BOOST_CHECK_EQUAL(outInterests[0], "1");
+  BOOST_CHECK_EQUAL(outInterests[5], "8"); // averaged: 0.8 * 10 packets/s
+  BOOST_CHECK_EQUAL(outInterests[7], "10");
+
+  auto inData = findRow(output->str(), "netDeviceFace://", "InData");
+  BOOST_REQUIRE_EQUAL(inData.size(), 9);
+  BOOST_CHECK_EQUAL(inData[7], "10");
+
+  auto inInterests = findRow(output->str(), "appFace://", "InInterests");
+  BOOST_REQUIRE_EQUAL(inInterests.size(), 9);
+  BOOST_CHECK_EQUAL(inInterests[7], "10");
+
+  auto satisfied = findRow(output->str(), "all", "SatisfiedInterests");
+  BOOST_REQUIRE_EQUAL(satisfied.size(), 9);
+  BOOST_CHECK_EQUAL(satisfied[2], "-1");
+  BOOST_CHECK_EQUAL(satisfied[7], "10");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
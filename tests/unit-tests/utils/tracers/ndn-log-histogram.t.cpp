@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-log-histogram.hpp"
+
+#include <cmath>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnLogHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  LogHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMean(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExactValues)
+{
+  LogHistogram histogram(8);
+  for (uint64_t i = 1; i <= 200; i++) {
+    histogram.Record(i);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 200);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 200);
+  BOOST_CHECK_EQUAL(histogram.GetMean(), 100.5);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 100);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(90), 180);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(99.9), 200);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 200);
+}
+
+BOOST_AUTO_TEST_CASE(Precision)
+{
+  LogHistogram histogram(8);
+  for (uint64_t i = 1; i <= 100000; i++) {
+    histogram.Record(i * 10);
+  }
+
+  // relative error is below 2^-7
+  for (double percentile : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+    double exact = std::ceil(percentile * 1000) * 10;
+    BOOST_CHECK_GE(histogram.GetPercentile(percentile), exact);
+    BOOST_CHECK_LE(histogram.GetPercentile(percentile), exact * (1 + 1.0 / 128));
+  }
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 1000000);
+}
+
+BOOST_AUTO_TEST_CASE(MergeAndReset)
+{
+  LogHistogram first;
+  LogHistogram second;
+  first.Record(5);
+  second.Record(1000000);
+  second.Record(3);
+
+  first.Merge(second);
+  BOOST_CHECK_EQUAL(first.GetCount(), 3);
+  BOOST_CHECK_EQUAL(first.GetMin(), 3);
+  BOOST_CHECK_EQUAL(first.GetMax(), 1000000);
+  BOOST_CHECK_EQUAL(first.GetPercentile(50), 5);
+
+  first.Reset();
+  BOOST_CHECK_EQUAL(first.GetCount(), 0);
+  BOOST_CHECK_EQUAL(first.GetMax(), 0);
+
+  first.Record(7);
+  BOOST_CHECK_EQUAL(first.GetMin(), 7);
+  BOOST_CHECK_EQUAL(first.GetPercentile(100), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
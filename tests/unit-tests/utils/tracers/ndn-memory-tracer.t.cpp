@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-memory-tracer.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class MemoryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  MemoryTracerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~MemoryTracerFixture()
+  {
+    MemoryTracer::Destroy();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnMemoryTracer, MemoryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Usage)
+{
+  MemoryTracer::NodeUsage inFlight;
+  Simulator::Schedule(Seconds(0.505), [&] { inFlight = MemoryTracer::GetUsage(getNode("1")); });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // Interest sent at 0.5s is pending
+  BOOST_CHECK_GE(inFlight[MemoryTracer::PIT].nEntries, 1);
+  BOOST_CHECK_GT(inFlight[MemoryTracer::PIT].nBytes, 0);
+
+  MemoryTracer::NodeUsage usage = MemoryTracer::GetUsage(getNode("1"));
+
+  // all PIT entries are gone, and so are their bytes
+  BOOST_CHECK_EQUAL(usage[MemoryTracer::PIT].nEntries, 0);
+  BOOST_CHECK_EQUAL(usage[MemoryTracer::PIT].nBytes, 0);
+
+  BOOST_CHECK_GT(usage[MemoryTracer::FIB].nEntries, 0);
+  BOOST_CHECK_GT(usage[MemoryTracer::FIB].nBytes, 0);
+  BOOST_CHECK_GT(usage[MemoryTracer::NAME_TREE].nBytes, 0);
+
+  // all 10 Data packets are cached
+  BOOST_CHECK_EQUAL(usage[MemoryTracer::CS].nEntries, 10);
+  BOOST_CHECK_GT(usage[MemoryTracer::CS].nBytes, 10 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(Trace)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  Ptr<MemoryTracer> tracer = Create<MemoryTracer>(output, NodeContainer(getNode("1")), Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  std::vector<std::string> lines;
+  boost::split(lines, output->str(), boost::is_any_of("\n"), boost::token_compress_on);
+  lines.pop_back(); // empty line after the last row
+
+  // node 1: every table and total, then the same for all nodes, and process RSS
+  BOOST_REQUIRE_EQUAL(lines.size(), 2 * (MemoryTracer::N_TABLES + 1) + 1);
+  BOOST_CHECK(boost::starts_with(lines[0], "1\t1\tNameTree\t"));
+  BOOST_CHECK(boost::starts_with(lines[MemoryTracer::N_TABLES], "1\t1\tTotal\t"));
+  BOOST_CHECK(boost::starts_with(lines[2 * MemoryTracer::N_TABLES + 1], "1\tall\tTotal\t"));
+  BOOST_CHECK(boost::starts_with(lines.back(), "1\tall\tProcessRss\t0\t"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-writer.hpp"
+#include "utils/tracers/ndn-trace-reader.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace.ndntrace";
+
+class TraceWriterFixture : public CleanupFixture
+{
+public:
+  TraceWriterFixture()
+    : columns({{"Time", TraceWriter::DOUBLE},
+               {"Node", TraceWriter::STRING},
+               {"FaceId", TraceWriter::INTEGER},
+               {"Packets", TraceWriter::DOUBLE}})
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~TraceWriterFixture()
+  {
+    boost::filesystem::remove(TEST_BINARY_TRACE);
+  }
+
+  std::string
+  writeAndConvert(TraceWriter::Encoding encoding)
+  {
+    {
+      TraceWriter writer(TEST_BINARY_TRACE.string(), columns, encoding, 3);
+      BOOST_REQUIRE(writer.IsOpen());
+      for (int i = 0; i < 10; i++) {
+        writer << i * 0.5 << (i % 2 == 0 ? "even" : "odd, \"quoted\"") << 256 + i % 4 - 2 << i;
+      }
+      writer << 5.0 << "incomplete"; // discarded
+    }
+
+    std::ostringstream os;
+    BOOST_CHECK(TraceReader::ConvertToCsv(TEST_BINARY_TRACE.string(), os));
+    return os.str();
+  }
+
+public:
+  std::vector<TraceWriter::Column> columns;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceWriter, TraceWriterFixture)
+
+const std::string EXPECTED_CSV =
+  "Time,Node,FaceId,Packets\n"
+  "0,even,254,0\n"
+  "0.5,\"odd, \"\"quoted\"\"\",255,1\n"
+  "1,even,256,2\n"
+  "1.5,\"odd, \"\"quoted\"\"\",257,3\n"
+  "2,even,254,4\n"
+  "2.5,\"odd, \"\"quoted\"\"\",255,5\n"
+  "3,even,256,6\n"
+  "3.5,\"odd, \"\"quoted\"\"\",257,7\n"
+  "4,even,254,8\n"
+  "4.5,\"odd, \"\"quoted\"\"\",255,9\n";
+
+BOOST_AUTO_TEST_CASE(Raw)
+{
+  BOOST_CHECK_EQUAL(writeAndConvert(TraceWriter::RAW), EXPECTED_CSV);
+}
+
+BOOST_AUTO_TEST_CASE(Packed)
+{
+  BOOST_CHECK_EQUAL(writeAndConvert(TraceWriter::PACKED), EXPECTED_CSV);
+}
+
+BOOST_AUTO_TEST_CASE(Reader)
+{
+  writeAndConvert(TraceWriter::PACKED);
+
+  TraceReader reader;
+  BOOST_REQUIRE(reader.Open(TEST_BINARY_TRACE.string()));
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 4);
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].name, "FaceId");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].type, TraceWriter::INTEGER);
+
+  size_t nRows = 0;
+  while (reader.Next()) {
+    BOOST_CHECK_EQUAL(reader.GetDouble(0), nRows * 0.5);
+    BOOST_CHECK_EQUAL(reader.GetString(1), nRows % 2 == 0 ? "even" : "odd, \"quoted\"");
+    BOOST_CHECK_EQUAL(reader.GetInteger(2), static_cast<int64_t>(256 + nRows % 4 - 2));
+    BOOST_CHECK_EQUAL(reader.GetDouble(3), nRows);
+    nRows++;
+  }
+  BOOST_CHECK_EQUAL(nRows, 10);
+}
+
+BOOST_AUTO_TEST_CASE(IdleWriter)
+{
+  {
+    TraceWriter writer(TEST_BINARY_TRACE.string(), columns, TraceWriter::PACKED, 2);
+    BOOST_REQUIRE(writer.IsOpen());
+    for (int i = 0; i < 6; i++) {
+      writer << i * 0.5 << "node" << i << i;
+      // let the writer thread drain the queue and go to sleep between chunks
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  TraceReader reader;
+  BOOST_REQUIRE(reader.Open(TEST_BINARY_TRACE.string()));
+  int64_t nRows = 0;
+  while (reader.Next()) {
+    BOOST_CHECK_EQUAL(reader.GetInteger(2), nRows);
+    nRows++;
+  }
+  BOOST_CHECK_EQUAL(nRows, 6);
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  writeAndConvert(TraceWriter::PACKED);
+  boost::filesystem::resize_file(TEST_BINARY_TRACE,
+                                 boost::filesystem::file_size(TEST_BINARY_TRACE) - 1);
+
+  std::ostringstream os;
+  BOOST_CHECK_EQUAL(TraceReader::ConvertToCsv(TEST_BINARY_TRACE.string(), os), false);
+
+  TraceReader reader;
+  BOOST_CHECK_EQUAL(reader.Open((boost::filesystem::path(TEST_CONFIG_PATH) / "none").string()),
+                    false);
+}
+
+BOOST_AUTO_TEST_CASE(IsBinaryFile)
+{
+  BOOST_CHECK_EQUAL(TraceWriter::IsBinaryFile("rate-trace.ndntrace"), true);
+  BOOST_CHECK_EQUAL(TraceWriter::IsBinaryFile("rate-trace.txt"), false);
+  BOOST_CHECK_EQUAL(TraceWriter::IsBinaryFile("-"), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
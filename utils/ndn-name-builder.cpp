@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-name-builder.hpp"
+
+#include "ns3/assert.h"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+const size_t NameBuilder::MAX_COMPONENTS;
+
+NameBuilder::NameBuilder()
+  : m_nComponents(0)
+{
+  m_prefix.wireEncode();
+}
+
+void
+NameBuilder::SetPrefix(const Name& prefix)
+{
+  // a Name that has not been modified keeps its wire; since the builder holds a reference to
+  // the buffer of the current prefix, the same address means the same prefix
+  const Block& wire = prefix.wireEncode();
+  const Block& current = m_prefix.wireEncode();
+  if (wire.wire() == current.wire() && wire.size() == current.size()) {
+    return;
+  }
+
+  m_prefix = prefix;
+}
+
+NameBuilder&
+NameBuilder::Append(bool hasMarker, uint8_t marker, uint64_t number)
+{
+  NS_ASSERT_MSG(m_nComponents < MAX_COMPONENTS, "Too many components appended to NameBuilder");
+
+  NumberComponent& component = m_components[m_nComponents++];
+  component.hasMarker = hasMarker;
+  component.marker = marker;
+  component.number = number;
+  return *this;
+}
+
+Name
+NameBuilder::Build()
+{
+  const Block& prefix = m_prefix.wireEncode();
+
+  // same sizes as the encoder below produces
+  ::ndn::EncodingEstimator estimator;
+  size_t valueLength = prefix.value_size();
+  for (size_t i = 0; i < m_nComponents; i++) {
+    size_t componentLength = estimator.prependNonNegativeInteger(m_components[i].number)
+                             + (m_components[i].hasMarker ? 1 : 0);
+    valueLength += estimator.prependVarNumber(::ndn::tlv::NameComponent)
+                   + estimator.prependVarNumber(componentLength) + componentLength;
+  }
+  size_t totalLength = estimator.prependVarNumber(::ndn::tlv::Name)
+                       + estimator.prependVarNumber(valueLength) + valueLength;
+
+  // components are prepended in reverse order into the exact-size buffer
+  ::ndn::EncodingBuffer encoder(totalLength, 0);
+  for (size_t i = m_nComponents; i > 0; i--) {
+    const NumberComponent& component = m_components[i - 1];
+    size_t componentLength = encoder.prependNonNegativeInteger(component.number);
+    if (component.hasMarker) {
+      componentLength += encoder.prependByte(component.marker);
+    }
+    encoder.prependVarNumber(componentLength);
+    encoder.prependVarNumber(::ndn::tlv::NameComponent);
+  }
+  encoder.prependRange(prefix.value_begin(), prefix.value_end());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Name);
+
+  m_nComponents = 0;
+  return Name(encoder.block());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_NAME_BUILDER_H
+#define NDN_NAME_BUILDER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Builder of names that consist of a fixed prefix followed by numeric components
+ *
+ * Name::appendNumber and Name::appendSequenceNumber encode every component into a buffer of
+ * its own, and the name is copied whenever it is extended.  The builder keeps the encoded
+ * prefix and writes the complete Name TLV, prefix and numeric components, into a single buffer
+ * of the exact size.  Components of the built Name refer to this buffer, so the Name does not
+ * have to be encoded again when the Interest is encoded.
+ *
+ * Example:
+ *
+ *     m_nameBuilder.SetPrefix(m_interestName);
+ *     interest->setName(m_nameBuilder.AppendNumber(prefix).AppendSequenceNumber(seq).Build());
+ */
+class NameBuilder {
+public:
+  /**
+   * @brief Maximum number of components that can be appended to the prefix
+   */
+  static const size_t MAX_COMPONENTS = 4;
+
+  NameBuilder();
+
+  /**
+   * @brief Set prefix of the built names
+   *
+   * Does nothing (no copying or encoding) if @p prefix is the current prefix.
+   */
+  void
+  SetPrefix(const Name& prefix);
+
+  const Name&
+  GetPrefix() const;
+
+  /**
+   * @brief Append component with nonNegativeInteger value, same as Name::appendNumber
+   */
+  NameBuilder&
+  AppendNumber(uint64_t number);
+
+  /**
+   * @brief Append sequence number component, same as Name::appendSequenceNumber
+   */
+  NameBuilder&
+  AppendSequenceNumber(uint64_t seqNo);
+
+  /**
+   * @brief Build name from the prefix and the appended components
+   *
+   * Appended components are cleared, the prefix is kept for the next name.
+   */
+  Name
+  Build();
+
+private:
+  NameBuilder&
+  Append(bool hasMarker, uint8_t marker, uint64_t number);
+
+private:
+  struct NumberComponent {
+    bool hasMarker;
+    uint8_t marker;
+    uint64_t number;
+  };
+
+  Name m_prefix;
+  NumberComponent m_components[MAX_COMPONENTS];
+  size_t m_nComponents;
+};
+
+inline const Name&
+NameBuilder::GetPrefix() const
+{
+  return m_prefix;
+}
+
+inline NameBuilder&
+NameBuilder::AppendNumber(uint64_t number)
+{
+  return Append(false, 0, number);
+}
+
+inline NameBuilder&
+NameBuilder::AppendSequenceNumber(uint64_t seqNo)
+{
+  return Append(true, ::ndn::name::SEQUENCE_NUMBER_MARKER, seqNo);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_NAME_BUILDER_H
@@ -20,13 +20,18 @@
 #ifndef NDN_NS3_PACKET_TAG_HPP
 #define NDN_NS3_PACKET_TAG_HPP
 
-#include "ns3/packet.h"
-#include "ns3/ptr.h"
 #include <ndn-cxx/tag.hpp>
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Network-level metadata of the ns-3 packet an Interest or Data was decoded from
+ *
+ * Decoded packets can stay in PIT in-records for their whole lifetime, so the tag keeps only
+ * the compact metadata that is needed later (the hop count), instead of the ns-3 packet and its
+ * tag list, which are released as soon as the packet is decoded.
+ */
 class Ns3PacketTag : public ::ndn::Tag {
 public:
   static size_t
@@ -35,19 +40,22 @@ public:
     return 0xaee87802; // md5("Ns3PacketTag")[0:8]
   }
 
-  Ns3PacketTag(Ptr<const Packet> packet)
-    : m_packet(packet)
+  explicit Ns3PacketTag(uint32_t hopCount)
+    : m_hopCount(hopCount)
   {
   }
 
-  Ptr<const Packet>
-  getPacket() const
+  /**
+   * @brief Get number of network hops the packet traveled (value of FwHopCountTag)
+   */
+  uint32_t
+  getHopCount() const
   {
-    return m_packet;
+    return m_hopCount;
   }
 
 private:
-  Ptr<const Packet> m_packet;
+  uint32_t m_hopCount;
 };
 
 } // namespace ndn
@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-outstanding-request-table.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_N_SLOTS = 64;
+static const size_t N_BUCKETS = 1024;
+
+const uint32_t OutstandingRequestTable::NO_PREFIX;
+const uint32_t OutstandingRequestTable::INVALID;
+
+OutstandingRequestTable::OutstandingRequestTable(Time tick)
+  : m_freeList(INVALID)
+  , m_size(0)
+  , m_slots(INITIAL_N_SLOTS, INVALID)
+  , m_slotMask(INITIAL_N_SLOTS - 1)
+  , m_tick(tick)
+  , m_bucketHead(N_BUCKETS, INVALID)
+  , m_bucketTail(N_BUCKETS, INVALID)
+  , m_cursor(std::numeric_limits<int64_t>::max())
+  , m_nArmed(0)
+{
+  NS_ASSERT(m_tick.IsStrictlyPositive());
+}
+
+void
+OutstandingRequestTable::SetTick(Time tick)
+{
+  NS_ASSERT(tick.IsStrictlyPositive());
+  if (tick == m_tick)
+    return;
+
+  std::vector<uint32_t> armed;
+  armed.reserve(m_nArmed);
+  for (uint32_t index = 0; index < m_entries.size(); index++) {
+    if (m_entries[index].m_isArmed) {
+      armed.push_back(index);
+      Disarm(index);
+    }
+  }
+
+  m_tick = tick;
+  m_cursor = std::numeric_limits<int64_t>::max();
+
+  // keep the order of transmissions inside the new buckets
+  std::sort(armed.begin(), armed.end(), [this](uint32_t a, uint32_t b) {
+    return m_entries[a].lastSent < m_entries[b].lastSent;
+  });
+  for (uint32_t index : armed) {
+    Arm(index);
+  }
+}
+
+const OutstandingRequestTable::Entry&
+OutstandingRequestTable::Send(uint32_t prefix, uint32_t seq, Time now)
+{
+  size_t slot = FindSlot(prefix, seq);
+  if (m_slots[slot] != INVALID) {
+    uint32_t index = m_slots[slot];
+    if (m_entries[index].m_isArmed)
+      Disarm(index);
+
+    m_entries[index].lastSent = now;
+    m_entries[index].retxCount++;
+    Arm(index);
+    return m_entries[index];
+  }
+
+  if ((m_size + 1) * 2 > m_slots.size()) {
+    Grow();
+    slot = FindSlot(prefix, seq);
+  }
+
+  uint32_t index = m_freeList;
+  if (index != INVALID) {
+    m_freeList = m_entries[index].m_next;
+  }
+  else {
+    index = m_entries.size();
+    m_entries.push_back(Entry());
+  }
+
+  Entry& entry = m_entries[index];
+  entry.prefix = prefix;
+  entry.seq = seq;
+  entry.firstSent = now;
+  entry.lastSent = now;
+  entry.retxCount = 1;
+  entry.m_isArmed = false;
+
+  m_slots[slot] = index;
+  m_size++;
+
+  Arm(index);
+  return entry;
+}
+
+const OutstandingRequestTable::Entry*
+OutstandingRequestTable::Find(uint32_t prefix, uint32_t seq) const
+{
+  uint32_t index = m_slots[FindSlot(prefix, seq)];
+  if (index == INVALID)
+    return nullptr;
+
+  return &m_entries[index];
+}
+
+bool
+OutstandingRequestTable::Erase(uint32_t prefix, uint32_t seq)
+{
+  size_t hole = FindSlot(prefix, seq);
+  uint32_t index = m_slots[hole];
+  if (index == INVALID)
+    return false;
+
+  if (m_entries[index].m_isArmed)
+    Disarm(index);
+
+  m_entries[index].m_next = m_freeList;
+  m_freeList = index;
+  m_size--;
+
+  // backward-shift deletion: move up entries of the probe sequence that can fill the hole
+  for (size_t slot = (hole + 1) & m_slotMask; m_slots[slot] != INVALID;
+       slot = (slot + 1) & m_slotMask) {
+    const Entry& entry = m_entries[m_slots[slot]];
+    size_t home = Hash(entry.prefix, entry.seq) & m_slotMask;
+    if (((slot - home) & m_slotMask) >= ((slot - hole) & m_slotMask)) {
+      m_slots[hole] = m_slots[slot];
+      hole = slot;
+    }
+  }
+  m_slots[hole] = INVALID;
+
+  return true;
+}
+
+void
+OutstandingRequestTable::Expire(Time deadline, std::vector<Key>& expired)
+{
+  if (m_nArmed == 0 || deadline.IsStrictlyNegative())
+    return;
+
+  int64_t target = GetTick(deadline);
+  if (target < m_cursor)
+    return;
+
+  if (static_cast<uint64_t>(target - m_cursor) < N_BUCKETS) {
+    for (int64_t tick = m_cursor; tick <= target && m_nArmed > 0; tick++) {
+      uint32_t index = m_bucketHead[tick & (N_BUCKETS - 1)];
+      while (index != INVALID) {
+        const Entry& entry = m_entries[index];
+        uint32_t next = entry.m_next;
+        // bucket can also hold entries of later rounds of the wheel
+        if (entry.lastSent <= deadline && GetTick(entry.lastSent) == tick) {
+          expired.push_back(Key(entry.prefix, entry.seq));
+          Disarm(index);
+        }
+        index = next;
+      }
+    }
+  }
+  else {
+    // the whole wheel is due, visit every bucket once and restore the order of transmissions
+    std::vector<uint32_t> due;
+    for (size_t bucket = 0; bucket < N_BUCKETS; bucket++) {
+      for (uint32_t index = m_bucketHead[bucket]; index != INVALID;
+           index = m_entries[index].m_next) {
+        if (m_entries[index].lastSent <= deadline)
+          due.push_back(index);
+      }
+    }
+
+    std::stable_sort(due.begin(), due.end(), [this](uint32_t a, uint32_t b) {
+      return m_entries[a].lastSent < m_entries[b].lastSent;
+    });
+    for (uint32_t index : due) {
+      expired.push_back(Key(m_entries[index].prefix, m_entries[index].seq));
+      Disarm(index);
+    }
+  }
+
+  // entries of the target tick sent after the deadline are still armed
+  m_cursor = target;
+}
+
+void
+OutstandingRequestTable::Clear()
+{
+  m_entries.clear();
+  m_freeList = INVALID;
+  m_size = 0;
+
+  m_slots.assign(INITIAL_N_SLOTS, INVALID);
+  m_slotMask = INITIAL_N_SLOTS - 1;
+
+  m_bucketHead.assign(N_BUCKETS, INVALID);
+  m_bucketTail.assign(N_BUCKETS, INVALID);
+  m_cursor = std::numeric_limits<int64_t>::max();
+  m_nArmed = 0;
+}
+
+uint64_t
+OutstandingRequestTable::Hash(uint32_t prefix, uint32_t seq)
+{
+  // finalizer of splitmix64, consecutive sequence numbers spread over the whole table
+  uint64_t hash = (static_cast<uint64_t>(prefix) << 32) | seq;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+size_t
+OutstandingRequestTable::FindSlot(uint32_t prefix, uint32_t seq) const
+{
+  size_t slot = Hash(prefix, seq) & m_slotMask;
+  while (m_slots[slot] != INVALID) {
+    const Entry& entry = m_entries[m_slots[slot]];
+    if (entry.prefix == prefix && entry.seq == seq)
+      break;
+    slot = (slot + 1) & m_slotMask;
+  }
+  return slot;
+}
+
+void
+OutstandingRequestTable::Grow()
+{
+  std::vector<uint32_t> slots(m_slots.size() * 2, INVALID);
+  size_t mask = slots.size() - 1;
+
+  for (uint32_t index : m_slots) {
+    if (index == INVALID)
+      continue;
+
+    size_t slot = Hash(m_entries[index].prefix, m_entries[index].seq) & mask;
+    while (slots[slot] != INVALID) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = index;
+  }
+
+  m_slots.swap(slots);
+  m_slotMask = mask;
+}
+
+int64_t
+OutstandingRequestTable::GetTick(Time time) const
+{
+  return time.GetTimeStep() / m_tick.GetTimeStep();
+}
+
+void
+OutstandingRequestTable::Arm(uint32_t index)
+{
+  Entry& entry = m_entries[index];
+  NS_ASSERT(!entry.m_isArmed);
+
+  int64_t tick = GetTick(entry.lastSent);
+  size_t bucket = tick & (N_BUCKETS - 1);
+
+  entry.m_prev = m_bucketTail[bucket];
+  entry.m_next = INVALID;
+  if (entry.m_prev != INVALID)
+    m_entries[entry.m_prev].m_next = index;
+  else
+    m_bucketHead[bucket] = index;
+  m_bucketTail[bucket] = index;
+
+  entry.m_isArmed = true;
+  m_nArmed++;
+  m_cursor = std::min(m_cursor, tick);
+}
+
+void
+OutstandingRequestTable::Disarm(uint32_t index)
+{
+  Entry& entry = m_entries[index];
+  NS_ASSERT(entry.m_isArmed);
+
+  size_t bucket = GetTick(entry.lastSent) & (N_BUCKETS - 1);
+  if (entry.m_prev != INVALID)
+    m_entries[entry.m_prev].m_next = entry.m_next;
+  else
+    m_bucketHead[bucket] = entry.m_next;
+
+  if (entry.m_next != INVALID)
+    m_entries[entry.m_next].m_prev = entry.m_prev;
+  else
+    m_bucketTail[bucket] = entry.m_prev;
+
+  entry.m_isArmed = false;
+  m_nArmed--;
+}
+
+} // namespace ndn
+} // namespace ns3
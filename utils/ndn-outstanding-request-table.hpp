@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_OUTSTANDING_REQUEST_TABLE_H
+#define NDN_OUTSTANDING_REQUEST_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Table of outstanding requests of a consumer application keyed by (prefix, seq)
+ *
+ * Entries live in a flat array and are located through an open-addressing hash table (linear
+ * probing, backward-shift deletion), so a lookup touches a few contiguous words and neither
+ * insertion nor removal allocates memory once the table has grown to its working size.
+ *
+ * Retransmission timeouts are driven by a hashed timing wheel: every armed entry is linked
+ * into the bucket of the tick of its last transmission.  Expire() walks only the buckets
+ * between the previous and the current deadline, instead of keeping a second ordered index
+ * of all entries.
+ *
+ * Requests that are not associated with a prefix number use NO_PREFIX.
+ */
+class OutstandingRequestTable : noncopyable {
+public:
+  static const uint32_t NO_PREFIX = std::numeric_limits<uint32_t>::max();
+
+  struct Entry {
+    uint32_t prefix;
+    uint32_t seq;
+    Time firstSent;     ///< time of the first transmission
+    Time lastSent;      ///< time of the last transmission
+    uint32_t retxCount; ///< number of transmissions (1 if never retransmitted)
+
+  private:
+    uint32_t m_prev; ///< previous entry in the timing wheel bucket
+    uint32_t m_next; ///< next entry in the timing wheel bucket (or the free list)
+    bool m_isArmed;
+
+    friend class OutstandingRequestTable;
+  };
+
+  typedef std::pair<uint32_t, uint32_t> Key; ///< (prefix, seq)
+
+  /**
+   * @param tick granularity of the timing wheel (retransmission check interval)
+   */
+  explicit OutstandingRequestTable(Time tick = MilliSeconds(50));
+
+  /**
+   * @brief Change granularity of the timing wheel, armed entries are redistributed
+   */
+  void
+  SetTick(Time tick);
+
+  /**
+   * @brief Record transmission of the request and (re)arm its timeout
+   *
+   * If the request is already outstanding, its last transmission time is updated and the
+   * retransmission count is incremented.
+   */
+  const Entry&
+  Send(uint32_t prefix, uint32_t seq, Time now);
+
+  /**
+   * @return entry of the request or nullptr if the request is not outstanding
+   */
+  const Entry*
+  Find(uint32_t prefix, uint32_t seq) const;
+
+  /**
+   * @brief Remove the request from the table
+   * @return false if the request was not outstanding
+   */
+  bool
+  Erase(uint32_t prefix, uint32_t seq);
+
+  /**
+   * @brief Disarm all requests last transmitted at or before @p deadline
+   *
+   * Expired requests stay in the table (their delays are still reported if Data arrives
+   * later) until they are sent again or erased.  Keys are appended to @p expired in the
+   * order of their last transmission.
+   */
+  void
+  Expire(Time deadline, std::vector<Key>& expired);
+
+  void
+  Clear();
+
+  /**
+   * @brief Number of requests in the table (armed and expired)
+   */
+  size_t
+  GetSize() const;
+
+  /**
+   * @brief Number of requests with armed timeout
+   */
+  size_t
+  GetNArmed() const;
+
+private:
+  static uint64_t
+  Hash(uint32_t prefix, uint32_t seq);
+
+  size_t
+  FindSlot(uint32_t prefix, uint32_t seq) const;
+
+  void
+  Grow();
+
+  int64_t
+  GetTick(Time time) const;
+
+  void
+  Arm(uint32_t index);
+
+  void
+  Disarm(uint32_t index);
+
+private:
+  static const uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+  std::vector<Entry> m_entries;
+  uint32_t m_freeList;
+  size_t m_size;
+
+  std::vector<uint32_t> m_slots; ///< index in m_entries or INVALID, size is a power of two
+  size_t m_slotMask;
+
+  Time m_tick;
+  std::vector<uint32_t> m_bucketHead; ///< size is a power of two
+  std::vector<uint32_t> m_bucketTail;
+  int64_t m_cursor; ///< ticks before the cursor do not have armed entries
+  size_t m_nArmed;
+};
+
+inline size_t
+OutstandingRequestTable::GetSize() const
+{
+  return m_size;
+}
+
+inline size_t
+OutstandingRequestTable::GetNArmed() const
+{
+  return m_nArmed;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_OUTSTANDING_REQUEST_TABLE_H
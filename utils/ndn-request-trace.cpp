@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RequestTrace");
+
+namespace ns3 {
+namespace ndn {
+
+static const char REQUEST_TRACE_MAGIC[8] = {'N', 'D', 'N', 'R', 'E', 'Q', 'S', '\0'};
+
+RequestTrace::RequestTrace()
+  : m_header(0)
+  , m_records(0)
+{
+}
+
+bool
+RequestTrace::Open(const std::string& file)
+{
+  Close();
+
+  boost::system::error_code error;
+  if (!boost::filesystem::is_regular_file(file, error)
+      || boost::filesystem::file_size(file, error) < sizeof(Header)) {
+    return false;
+  }
+
+  try {
+    m_file.open(file);
+  }
+  catch (const std::exception& e) {
+    NS_LOG_WARN("Cannot map " << file << ": " << e.what());
+    return false;
+  }
+
+  m_header = reinterpret_cast<const Header*>(m_file.data());
+  if (std::memcmp(m_header->magic, REQUEST_TRACE_MAGIC, sizeof(REQUEST_TRACE_MAGIC)) != 0
+      || m_header->version != FORMAT_VERSION || m_header->recordSize != sizeof(Record)) {
+    NS_LOG_WARN(file << " is not a request trace (or has an unsupported version)");
+    Close();
+    return false;
+  }
+
+  if (sizeof(Header) + m_header->nRecords * sizeof(Record) != m_file.size()) {
+    NS_LOG_WARN(file << " is truncated or corrupted");
+    Close();
+    return false;
+  }
+
+  m_records = reinterpret_cast<const Record*>(m_header + 1);
+  return true;
+}
+
+bool
+RequestTrace::IsOpen() const
+{
+  return m_header != 0;
+}
+
+void
+RequestTrace::Close()
+{
+  if (m_file.is_open()) {
+    m_file.close();
+  }
+
+  m_header = 0;
+  m_records = 0;
+}
+
+uint64_t
+RequestTrace::GetNRecords() const
+{
+  return IsOpen() ? m_header->nRecords : 0;
+}
+
+const RequestTrace::Record&
+RequestTrace::GetRecord(uint64_t index) const
+{
+  NS_ASSERT(IsOpen() && index < m_header->nRecords);
+  return m_records[index];
+}
+
+RequestTraceWriter::RequestTraceWriter()
+  : m_nRecords(0)
+  , m_lastTime(std::numeric_limits<int64_t>::min())
+{
+}
+
+RequestTraceWriter::~RequestTraceWriter()
+{
+  Close();
+}
+
+bool
+RequestTraceWriter::Open(const std::string& file)
+{
+  Close();
+
+  m_os.open(file.c_str(), std::ios::binary | std::ios::trunc);
+  if (!m_os.is_open()) {
+    NS_LOG_WARN("Cannot open " << file << " for writing");
+    return false;
+  }
+
+  RequestTrace::Header header;
+  std::memset(&header, 0, sizeof(header));
+  m_os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  m_nRecords = 0;
+  m_lastTime = std::numeric_limits<int64_t>::min();
+  return true;
+}
+
+void
+RequestTraceWriter::Write(const RequestTrace::Record& record)
+{
+  NS_ASSERT(m_os.is_open());
+  NS_ASSERT_MSG(record.time >= m_lastTime, "Records must be written in time order");
+
+  m_os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  m_lastTime = record.time;
+  m_nRecords++;
+}
+
+void
+RequestTraceWriter::Close()
+{
+  if (!m_os.is_open())
+    return;
+
+  // header is written last, so an incomplete file is never recognized as a valid trace
+  RequestTrace::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, REQUEST_TRACE_MAGIC, sizeof(REQUEST_TRACE_MAGIC));
+  header.version = RequestTrace::FORMAT_VERSION;
+  header.recordSize = sizeof(RequestTrace::Record);
+  header.nRecords = m_nRecords;
+
+  m_os.seekp(0);
+  m_os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!m_os.good()) {
+    NS_LOG_WARN("Failed to write request trace");
+  }
+  m_os.close();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Binary trace of content requests, replayed by TraceReplay
+ *
+ * The file consists of a fixed header followed by fixed-width records sorted by time.  The
+ * file is accessed through a read-only memory mapping, so records are neither parsed nor
+ * copied, and the pages that have been replayed can be reclaimed by the OS at any time.
+ */
+class RequestTrace {
+public:
+  static const uint32_t FORMAT_VERSION = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t nRecords;
+  };
+
+  struct Record {
+    int64_t time;          ///< request time in nanoseconds
+    uint32_t consumerNode; ///< ID of the node that runs the consumer
+    uint32_t producer;     ///< producer number (/prefix/<producer>)
+    uint32_t content;      ///< sequence number of the first chunk
+    uint32_t nChunks;      ///< number of chunks
+    uint32_t scope;        ///< flood scope of the Interests
+    uint32_t reserved;
+  };
+
+public:
+  RequestTrace();
+
+  /**
+   * @brief Map the trace file into memory
+   * @return false if file does not exist or is not a valid request trace
+   */
+  bool
+  Open(const std::string& file);
+
+  bool
+  IsOpen() const;
+
+  void
+  Close();
+
+  uint64_t
+  GetNRecords() const;
+
+  const Record&
+  GetRecord(uint64_t index) const;
+
+private:
+  boost::iostreams::mapped_file_source m_file;
+  const Header* m_header;
+  const Record* m_records;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Writer of binary request traces (e.g., to convert production request logs)
+ *
+ * Records must be written in non-decreasing time order.
+ */
+class RequestTraceWriter {
+public:
+  RequestTraceWriter();
+
+  ~RequestTraceWriter();
+
+  /**
+   * @brief Create (truncate) the trace file
+   * @return false if file cannot be created
+   */
+  bool
+  Open(const std::string& file);
+
+  void
+  Write(const RequestTrace::Record& record);
+
+  /**
+   * @brief Write number of records into the header and close the file
+   */
+  void
+  Close();
+
+private:
+  std::ofstream m_os;
+  uint64_t m_nRecords;
+  int64_t m_lastTime;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
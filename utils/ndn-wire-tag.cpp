@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-wire-tag.hpp"
+
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+TypeId
+WireTag::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::WireTag").SetParent<Tag>().AddConstructor<WireTag>();
+  return tid;
+}
+
+TypeId
+WireTag::GetInstanceTypeId() const
+{
+  return WireTag::GetTypeId();
+}
+
+uint64_t
+WireTag::GetCurrentProcess()
+{
+  static const uint64_t process = [] {
+    std::random_device device;
+    std::uniform_int_distribution<uint64_t> distribution(1);
+    return distribution(device);
+  }();
+  return process;
+}
+
+uint32_t
+WireTag::GetSerializedSize() const
+{
+  return 2 * sizeof(uint64_t);
+}
+
+void
+WireTag::Serialize(TagBuffer i) const
+{
+  i.WriteU64(m_process);
+  i.WriteU64(m_id);
+}
+
+void
+WireTag::Deserialize(TagBuffer i)
+{
+  m_process = i.ReadU64();
+  m_id = i.ReadU64();
+}
+
+void
+WireTag::Print(std::ostream& os) const
+{
+  os << std::hex << m_process << std::dec << ":" << m_id;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_WIRE_TAG_H
+#define NDN_WIRE_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Packet tag that links ns-3 packet to the NDN packet whose wire it carries
+ *
+ * Convert::ToPacket assigns every serialized Data a process-wide identifier and keeps an
+ * immutable snapshot of the packet in a bounded cache.  When the ns-3 packet is received by
+ * another node of the same simulation, Convert::FromPacket uses the identifier to copy the
+ * already decoded snapshot, which shares its wire buffer, instead of copying and decoding the
+ * bytes.  Interests are not tagged, their wire is modified in place by the forwarder.
+ *
+ * The tag is serialized together with the packet, so it can arrive in another process (e.g.,
+ * another MPI rank).  The identifier is therefore paired with a random token of the process
+ * that assigned it, and identifiers of other processes are never looked up.
+ */
+class WireTag : public Tag {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  WireTag(uint64_t process = 0, uint64_t id = 0)
+    : m_process(process)
+    , m_id(id)
+  {
+  }
+
+  /**
+   * @brief Get token of the process that assigned the identifier
+   */
+  uint64_t
+  GetProcess() const
+  {
+    return m_process;
+  }
+
+  /**
+   * @brief Get identifier assigned by Convert::ToPacket
+   */
+  uint64_t
+  Get() const
+  {
+    return m_id;
+  }
+
+  /**
+   * @brief Get random token of the current process, never 0
+   */
+  static uint64_t
+  GetCurrentProcess();
+
+  ////////////////////////////////////////////////////////
+  // from ObjectBase
+  ////////////////////////////////////////////////////////
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  ////////////////////////////////////////////////////////
+  // from Tag
+  ////////////////////////////////////////////////////////
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  uint64_t m_process;
+  uint64_t m_id;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_WIRE_TAG_H
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-mandelbrot-sampler.hpp"
+
+#include "ns3/log.h"
+
+#include <cmath>
+#include <map>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ZipfMandelbrotSampler");
+
+namespace ns3 {
+namespace ndn {
+
+shared_ptr<const ZipfMandelbrotSampler>
+ZipfMandelbrotSampler::Get(uint32_t n, double q, double s)
+{
+  static std::map<std::tuple<uint32_t, double, double>, weak_ptr<const ZipfMandelbrotSampler>>
+    samplers;
+
+  // drop tables released by all users, so that sweeping parameters does not grow the registry
+  for (auto it = samplers.begin(); it != samplers.end();) {
+    if (it->second.expired())
+      it = samplers.erase(it);
+    else
+      ++it;
+  }
+
+  weak_ptr<const ZipfMandelbrotSampler>& cached = samplers[std::make_tuple(n, q, s)];
+  shared_ptr<const ZipfMandelbrotSampler> sampler = cached.lock();
+  if (sampler == nullptr) {
+    sampler = make_shared<ZipfMandelbrotSampler>(n, q, s);
+    cached = sampler;
+  }
+  return sampler;
+}
+
+ZipfMandelbrotSampler::ZipfMandelbrotSampler(uint32_t n, double q, double s)
+  : m_n(n)
+  , m_prob(n)
+  , m_alias(n)
+{
+  if (n == 0)
+    NS_FATAL_ERROR("Zipf-Mandelbrot distribution requires at least one content");
+  NS_LOG_DEBUG("Building alias table for N=" << n << " q=" << q << " s=" << s);
+
+  double sum = 0.0;
+  for (uint32_t k = 1; k <= n; k++) {
+    m_prob[k - 1] = 1.0 / std::pow(k + q, s);
+    sum += m_prob[k - 1];
+  }
+
+  // Vose's algorithm: split columns into underfull and overfull, then pair them
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t i = 0; i < n; i++) {
+    m_prob[i] = m_prob[i] * n / sum;
+    m_alias[i] = i;
+    if (m_prob[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    small.pop_back();
+    uint32_t more = large.back();
+
+    m_alias[less] = more;
+    m_prob[more] = (m_prob[more] + m_prob[less]) - 1.0;
+    if (m_prob[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // leftovers are full up to rounding errors
+  for (uint32_t i : large)
+    m_prob[i] = 1.0;
+  for (uint32_t i : small)
+    m_prob[i] = 1.0;
+}
+
+uint32_t
+ZipfMandelbrotSampler::Sample(double uniform) const
+{
+  NS_ASSERT(m_n > 0);
+
+  double x = uniform * m_n;
+  uint32_t column = static_cast<uint32_t>(x);
+  if (column >= m_n) // uniform is (almost) 1
+    column = m_n - 1;
+
+  return (x - column < m_prob[column] ? column : m_alias[column]) + 1;
+}
+
+double
+ZipfMandelbrotSampler::GetProbability(uint32_t k) const
+{
+  NS_ASSERT(k >= 1 && k <= m_n);
+
+  // reconstruct from the alias table: own share plus shares donated by other columns
+  double p = m_prob[k - 1];
+  for (uint32_t i = 0; i < m_n; i++) {
+    if (m_alias[i] == k - 1 && i != k - 1)
+      p += 1.0 - m_prob[i];
+  }
+  return p / m_n;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ZIPF_MANDELBROT_SAMPLER_H
+#define NDN_ZIPF_MANDELBROT_SAMPLER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sampler of Zipf-Mandelbrot distribution over [1, N] with p(k) ~ 1/(k+q)^s
+ *
+ * Uses Walker's alias method: the table is built in O(N) and every draw takes O(1) time and
+ * a single uniform random number.  Tables are immutable and shared by all users that request
+ * the same (N, q, s), see Get().
+ */
+class ZipfMandelbrotSampler : noncopyable {
+public:
+  /**
+   * @brief Get sampler for the given parameters, creating the table if it does not exist yet
+   *
+   * The table is released when the last user releases the returned pointer.
+   * @pre n > 0
+   */
+  static shared_ptr<const ZipfMandelbrotSampler>
+  Get(uint32_t n, double q, double s);
+
+  /**
+   * @brief Build alias table for N contents; fails fatally when @p n is 0
+   */
+  ZipfMandelbrotSampler(uint32_t n, double q, double s);
+
+  /**
+   * @brief Map a uniform random number in [0, 1) to a content index in [1, N]
+   */
+  uint32_t
+  Sample(double uniform) const;
+
+  /**
+   * @brief Get probability of content index @p k (1 <= k <= N) as realized by the alias table
+   * @note O(N), intended for verification
+   */
+  double
+  GetProbability(uint32_t k) const;
+
+  uint32_t
+  GetN() const;
+
+private:
+  uint32_t m_n;
+  std::vector<double> m_prob;    ///< probability of keeping the column, scaled to [0, 1]
+  std::vector<uint32_t> m_alias; ///< alternative of the column (0-based)
+};
+
+inline uint32_t
+ZipfMandelbrotSampler::GetN() const
+{
+  return m_n;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ZIPF_MANDELBROT_SAMPLER_H
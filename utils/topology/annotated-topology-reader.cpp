@@ -41,6 +41,7 @@
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/rng-seed-manager.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
@@ -266,6 +267,122 @@ AnnotatedTopologyReader::Read(void)
   return m_nodes;
 }
 
+NodeContainer
+AnnotatedTopologyReader::ReadCached(const std::string& cacheFile)
+{
+  uint64_t fingerprint = GetSourceFingerprint();
+
+  CompiledTopology compiled;
+  if (compiled.Open(cacheFile) && LoadCompiled(compiled, fingerprint, true)) {
+    NS_LOG_INFO("Topology loaded from compiled cache " << cacheFile);
+    return m_nodes;
+  }
+
+  Read();
+  SaveCompiled(cacheFile, fingerprint);
+  return m_nodes;
+}
+
+NodeContainer
+AnnotatedTopologyReader::ReadCompiled(const std::string& file)
+{
+  CompiledTopology compiled;
+  if (!compiled.Open(file)) {
+    NS_FATAL_ERROR("Cannot open compiled topology " << file);
+    return m_nodes;
+  }
+
+  LoadCompiled(compiled, 0, false);
+  return m_nodes;
+}
+
+bool
+AnnotatedTopologyReader::LoadCompiled(const CompiledTopology& compiled, uint64_t fingerprint,
+                                      bool checkSource)
+{
+  const CompiledTopology::Header& header = compiled.GetHeader();
+  if (checkSource) {
+    if (header.fingerprint != fingerprint) {
+      NS_LOG_INFO("Compiled topology was created from a different source");
+      return false;
+    }
+    if (header.seed != RngSeedManager::GetSeed() || header.run != RngSeedManager::GetRun()) {
+      NS_LOG_INFO("Compiled topology was created with seed " << header.seed << " and run "
+                                                            << header.run);
+      return false;
+    }
+  }
+
+  std::vector<Ptr<Node>> nodes;
+  nodes.reserve(header.nNodes);
+  for (uint32_t i = 0; i < header.nNodes; i++) {
+    const CompiledTopology::NodeRecord& record = compiled.GetNode(i);
+    std::string name = compiled.GetString(record.name);
+
+    Ptr<Node> node;
+    if (record.hasPosition)
+      node = CreateNode(name, record.posX, record.posY, record.systemId);
+    else
+      node = CreateNode(name, record.systemId);
+
+    OnCompiledNodeCreated(node, static_cast<CompiledTopology::NodeRole>(record.role));
+    nodes.push_back(node);
+  }
+
+  for (uint32_t i = 0; i < header.nLinks; i++) {
+    const CompiledTopology::LinkRecord& record = compiled.GetLink(i);
+    NS_ASSERT(record.fromNode < nodes.size() && record.toNode < nodes.size());
+
+    Link link(nodes[record.fromNode], compiled.GetString(compiled.GetNode(record.fromNode).name),
+              nodes[record.toNode], compiled.GetString(compiled.GetNode(record.toNode).name));
+
+    for (uint32_t attr = record.firstAttribute; attr < record.firstAttribute + record.nAttributes;
+         attr++) {
+      const CompiledTopology::AttributeRecord& attribute = compiled.GetAttribute(attr);
+      link.SetAttribute(compiled.GetString(attribute.key), compiled.GetString(attribute.value));
+    }
+
+    AddLink(link);
+  }
+
+  NS_LOG_INFO("Compiled topology loaded with " << m_nodes.GetN() << " nodes and " << LinksSize()
+                                               << " links");
+
+  ApplySettings();
+  return true;
+}
+
+void
+AnnotatedTopologyReader::SaveCompiled(const std::string& file, uint64_t fingerprint)
+{
+  std::vector<CompiledTopology::NodeRole> roles;
+  roles.reserve(m_nodes.GetN());
+  for (NodeContainer::Iterator node = m_nodes.Begin(); node != m_nodes.End(); node++) {
+    roles.push_back(GetCompiledNodeRole(*node));
+  }
+
+  CompiledTopology::Write(file, fingerprint, m_nodes, roles, m_linksList);
+}
+
+CompiledTopology::NodeRole
+AnnotatedTopologyReader::GetCompiledNodeRole(Ptr<Node> node) const
+{
+  return CompiledTopology::ROLE_NONE;
+}
+
+void
+AnnotatedTopologyReader::OnCompiledNodeCreated(Ptr<Node> node, CompiledTopology::NodeRole role)
+{
+}
+
+uint64_t
+AnnotatedTopologyReader::GetSourceFingerprint() const
+{
+  uint64_t fingerprint = CompiledTopology::HashFile(GetFileName());
+  fingerprint = CompiledTopology::Hash(&m_scale, sizeof(m_scale), fingerprint);
+  return fingerprint;
+}
+
 void
 AnnotatedTopologyReader::AssignIpv4Addresses(Ipv4Address base)
 {
@@ -22,6 +22,8 @@
 #ifndef __ANNOTATED_TOPOLOGY_READER_H__
 #define __ANNOTATED_TOPOLOGY_READER_H__
 
+#include "compiled-topology.hpp"
+
 #include "ns3/topology-reader.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
@@ -56,6 +58,26 @@ public:
   virtual NodeContainer
   Read();
 
+  /**
+   * \brief Read topology using compiled topology cache
+   *
+   * If \p cacheFile exists, was compiled from the same topology file, and with the same RNG
+   * seed and run number, the topology is loaded from the cache.  Otherwise, the text file is
+   * read and the result is saved to \p cacheFile for the subsequent runs.
+   *
+   * \return the container of the nodes created
+   */
+  virtual NodeContainer
+  ReadCached(const std::string& cacheFile);
+
+  /**
+   * \brief Read compiled topology (previously saved using SaveCompiled)
+   *
+   * \return the container of the nodes created
+   */
+  virtual NodeContainer
+  ReadCompiled(const std::string& file);
+
   /**
    * \brief Get nodes read by the reader
    */
@@ -115,6 +137,14 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+  /**
+   * \brief Save topology in the binary format that can be loaded using ReadCompiled
+   * \param file output file name
+   * \param fingerprint value identifying the source of the topology (checked by ReadCached)
+   */
+  virtual void
+  SaveCompiled(const std::string& file, uint64_t fingerprint = 0);
+
 protected:
   Ptr<Node>
   CreateNode(const std::string name, uint32_t systemId);
@@ -131,6 +161,33 @@ protected:
   void
   ApplySettings();
 
+  /**
+   * \brief Create nodes and links from the compiled topology
+   *
+   * \return false if compiled topology was created from a different source (\p fingerprint)
+   *         or using different RNG seed or run number
+   */
+  bool
+  LoadCompiled(const CompiledTopology& compiled, uint64_t fingerprint, bool checkSource);
+
+  /**
+   * \brief Role of the node to be recorded in the compiled topology
+   */
+  virtual CompiledTopology::NodeRole
+  GetCompiledNodeRole(Ptr<Node> node) const;
+
+  /**
+   * \brief Called for each node created from the compiled topology
+   */
+  virtual void
+  OnCompiledNodeCreated(Ptr<Node> node, CompiledTopology::NodeRole role);
+
+  /**
+   * \brief Fingerprint of the topology source (topology file and reader parameters)
+   */
+  uint64_t
+  GetSourceFingerprint() const;
+
 protected:
   std::string m_path;
   NodeContainer m_nodes;
@@ -0,0 +1,365 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "compiled-topology.hpp"
+
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/mobility-model.h"
+#include "ns3/rng-seed-manager.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE("CompiledTopology");
+
+namespace ns3 {
+
+static const char COMPILED_TOPOLOGY_MAGIC[8] = {'N', 'D', 'N', 'T', 'O', 'P', 'O', '\0'};
+
+CompiledTopology::CompiledTopology()
+  : m_header(0)
+  , m_nodes(0)
+  , m_links(0)
+  , m_attributes(0)
+  , m_strings(0)
+{
+}
+
+bool
+CompiledTopology::Open(const std::string& file)
+{
+  Close();
+
+  boost::system::error_code error;
+  if (!boost::filesystem::is_regular_file(file, error)
+      || boost::filesystem::file_size(file, error) < sizeof(Header)) {
+    return false;
+  }
+
+  try {
+    m_file.open(file);
+  }
+  catch (const std::exception& e) {
+    NS_LOG_WARN("Cannot map " << file << ": " << e.what());
+    return false;
+  }
+
+  const char* begin = m_file.data();
+  size_t size = m_file.size();
+
+  m_header = reinterpret_cast<const Header*>(begin);
+  if (std::memcmp(m_header->magic, COMPILED_TOPOLOGY_MAGIC, sizeof(COMPILED_TOPOLOGY_MAGIC)) != 0
+      || m_header->version != FORMAT_VERSION) {
+    NS_LOG_WARN(file << " is not a compiled topology (or has an unsupported version)");
+    Close();
+    return false;
+  }
+
+  size_t expectedSize = sizeof(Header) + m_header->nNodes * sizeof(NodeRecord)
+                        + m_header->nLinks * sizeof(LinkRecord)
+                        + m_header->nAttributes * sizeof(AttributeRecord) + m_header->stringsSize;
+  if (expectedSize != size) {
+    NS_LOG_WARN(file << " is truncated or corrupted");
+    Close();
+    return false;
+  }
+
+  m_nodes = reinterpret_cast<const NodeRecord*>(begin + sizeof(Header));
+  m_links = reinterpret_cast<const LinkRecord*>(m_nodes + m_header->nNodes);
+  m_attributes = reinterpret_cast<const AttributeRecord*>(m_links + m_header->nLinks);
+  m_strings = reinterpret_cast<const char*>(m_attributes + m_header->nAttributes);
+
+  if (!IsValid()) {
+    NS_LOG_WARN(file << " is corrupted");
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+bool
+CompiledTopology::IsValid() const
+{
+  // every string, including the last one, must be terminated within the string table
+  if (m_header->stringsSize > 0 && m_strings[m_header->stringsSize - 1] != '\0') {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < m_header->nNodes; i++) {
+    const NodeRecord& node = m_nodes[i];
+    if (node.name >= m_header->stringsSize || node.role > ROLE_BACKBONE) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < m_header->nLinks; i++) {
+    const LinkRecord& link = m_links[i];
+    if (link.fromNode >= m_header->nNodes || link.toNode >= m_header->nNodes
+        || link.firstAttribute > m_header->nAttributes
+        || link.nAttributes > m_header->nAttributes - link.firstAttribute) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < m_header->nAttributes; i++) {
+    const AttributeRecord& attribute = m_attributes[i];
+    if (attribute.key >= m_header->stringsSize || attribute.value >= m_header->stringsSize) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+CompiledTopology::IsOpen() const
+{
+  return m_header != 0;
+}
+
+void
+CompiledTopology::Close()
+{
+  if (m_file.is_open()) {
+    m_file.close();
+  }
+
+  m_header = 0;
+  m_nodes = 0;
+  m_links = 0;
+  m_attributes = 0;
+  m_strings = 0;
+}
+
+const CompiledTopology::Header&
+CompiledTopology::GetHeader() const
+{
+  NS_ASSERT(IsOpen());
+  return *m_header;
+}
+
+const CompiledTopology::NodeRecord&
+CompiledTopology::GetNode(uint32_t index) const
+{
+  NS_ASSERT(IsOpen() && index < m_header->nNodes);
+  return m_nodes[index];
+}
+
+const CompiledTopology::LinkRecord&
+CompiledTopology::GetLink(uint32_t index) const
+{
+  NS_ASSERT(IsOpen() && index < m_header->nLinks);
+  return m_links[index];
+}
+
+const CompiledTopology::AttributeRecord&
+CompiledTopology::GetAttribute(uint32_t index) const
+{
+  NS_ASSERT(IsOpen() && index < m_header->nAttributes);
+  return m_attributes[index];
+}
+
+const char*
+CompiledTopology::GetString(uint32_t offset) const
+{
+  NS_ASSERT(IsOpen() && offset < m_header->stringsSize);
+  return m_strings + offset;
+}
+
+/// @cond include_hidden
+
+class StringTable {
+public:
+  uint32_t
+  Add(const std::string& str)
+  {
+    std::map<std::string, uint32_t>::iterator i = m_offsets.find(str);
+    if (i != m_offsets.end())
+      return i->second;
+
+    uint32_t offset = m_data.size();
+    m_data.insert(m_data.end(), str.begin(), str.end());
+    m_data.push_back('\0');
+    m_offsets.insert(std::make_pair(str, offset));
+    return offset;
+  }
+
+  const std::vector<char>&
+  GetData() const
+  {
+    return m_data;
+  }
+
+private:
+  std::vector<char> m_data;
+  std::map<std::string, uint32_t> m_offsets;
+};
+
+/// @endcond
+
+void
+CompiledTopology::Write(const std::string& file, uint64_t fingerprint, const NodeContainer& nodes,
+                        const std::vector<NodeRole>& roles,
+                        const std::list<TopologyReader::Link>& links)
+{
+  NS_ASSERT(roles.empty() || roles.size() == nodes.GetN());
+
+  StringTable strings;
+  std::map<uint32_t, uint32_t> nodeIndex; // node id -> record index
+
+  std::vector<NodeRecord> nodeRecords;
+  nodeRecords.reserve(nodes.GetN());
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Ptr<Node> node = nodes.Get(i);
+
+    NodeRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.name = strings.Add(Names::FindName(node));
+    record.systemId = node->GetSystemId();
+    record.role = roles.empty() ? ROLE_NONE : roles[i];
+
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    if (mobility != 0) {
+      record.hasPosition = 1;
+      record.posX = mobility->GetPosition().x;
+      record.posY = mobility->GetPosition().y;
+    }
+
+    nodeIndex[node->GetId()] = i;
+    nodeRecords.push_back(record);
+  }
+
+  std::vector<LinkRecord> linkRecords;
+  std::vector<AttributeRecord> attributeRecords;
+  linkRecords.reserve(links.size());
+  for (std::list<TopologyReader::Link>::const_iterator i = links.begin(); i != links.end(); i++) {
+    TopologyReader::Link link = *i;
+
+    LinkRecord record;
+    record.fromNode = nodeIndex[link.GetFromNode()->GetId()];
+    record.toNode = nodeIndex[link.GetToNode()->GetId()];
+    record.firstAttribute = attributeRecords.size();
+
+    for (TopologyReader::Link::ConstAttributesIterator attr = link.AttributesBegin();
+         attr != link.AttributesEnd(); attr++) {
+      AttributeRecord attribute;
+      attribute.key = strings.Add(attr->first);
+      attribute.value = strings.Add(attr->second);
+      attributeRecords.push_back(attribute);
+    }
+    record.nAttributes = attributeRecords.size() - record.firstAttribute;
+
+    linkRecords.push_back(record);
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, COMPILED_TOPOLOGY_MAGIC, sizeof(COMPILED_TOPOLOGY_MAGIC));
+  header.version = FORMAT_VERSION;
+  header.seed = RngSeedManager::GetSeed();
+  header.run = RngSeedManager::GetRun();
+  header.fingerprint = fingerprint;
+  header.nNodes = nodeRecords.size();
+  header.nLinks = linkRecords.size();
+  header.nAttributes = attributeRecords.size();
+  header.stringsSize = strings.GetData().size();
+
+  // write to a temporary file with a unique name first and rename it into place, so concurrent
+  // runs neither read a partially written file nor write into each other's temporary file
+  boost::system::error_code error;
+  std::string tmpFile =
+    boost::filesystem::unique_path(file + ".%%%%-%%%%-%%%%.tmp", error).string();
+  if (error) {
+    NS_LOG_WARN("Cannot generate temporary file name for " << file << ": " << error.message());
+    return;
+  }
+
+  bool isWritten = false;
+  {
+    std::ofstream os(tmpFile.c_str(), std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+      NS_LOG_WARN("Cannot open " << tmpFile << " for writing");
+      return;
+    }
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!nodeRecords.empty())
+      os.write(reinterpret_cast<const char*>(&nodeRecords[0]),
+               nodeRecords.size() * sizeof(NodeRecord));
+    if (!linkRecords.empty())
+      os.write(reinterpret_cast<const char*>(&linkRecords[0]),
+               linkRecords.size() * sizeof(LinkRecord));
+    if (!attributeRecords.empty())
+      os.write(reinterpret_cast<const char*>(&attributeRecords[0]),
+               attributeRecords.size() * sizeof(AttributeRecord));
+    if (!strings.GetData().empty())
+      os.write(&strings.GetData()[0], strings.GetData().size());
+
+    os.close();
+    isWritten = !os.fail();
+  }
+
+  if (!isWritten) {
+    NS_LOG_WARN("Failed to write " << tmpFile);
+    boost::filesystem::remove(tmpFile, error);
+    return;
+  }
+
+  boost::filesystem::rename(tmpFile, file, error);
+  if (error) {
+    NS_LOG_WARN("Cannot rename " << tmpFile << " to " << file << ": " << error.message());
+    boost::filesystem::remove(tmpFile, error);
+  }
+}
+
+uint64_t
+CompiledTopology::Hash(const void* data, size_t size, uint64_t hash)
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t
+CompiledTopology::Hash(const std::string& data, uint64_t hash)
+{
+  return Hash(data.data(), data.size(), hash);
+}
+
+uint64_t
+CompiledTopology::HashFile(const std::string& file, uint64_t hash)
+{
+  boost::system::error_code error;
+  if (!boost::filesystem::is_regular_file(file, error)
+      || boost::filesystem::file_size(file, error) == 0)
+    return hash;
+
+  boost::iostreams::mapped_file_source source(file);
+  return Hash(source.data(), source.size(), hash);
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef COMPILED_TOPOLOGY_H
+#define COMPILED_TOPOLOGY_H
+
+#include "ns3/topology-reader.h"
+#include "ns3/node-container.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Binary (compiled) representation of a topology read by AnnotatedTopologyReader or
+ *        RocketfuelMapReader
+ *
+ * The file consists of a fixed header followed by node, link, and link attribute record
+ * arrays and a string table with NUL-terminated strings.  All records have fixed width, so
+ * the file is used directly through a read-only memory mapping, without any text parsing.
+ *
+ * Link attributes (DataRate, Delay, OSPF, MaxPackets, LossRate) are stored exactly as they
+ * were assigned when the topology has been compiled, including the randomly sampled values
+ * of RocketfuelMapReader.  The header records RNG seed and run number that were in effect,
+ * so the loaded topology is identical to the one produced by the text reader.
+ */
+class CompiledTopology {
+public:
+  static const uint32_t FORMAT_VERSION = 1;
+
+  /**
+   * \brief Role of the node (values match RocketfuelMapReader classification)
+   */
+  enum NodeRole { ROLE_NONE = 0, ROLE_CUSTOMER = 1, ROLE_GATEWAY = 2, ROLE_BACKBONE = 3 };
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t seed;
+    uint64_t run;
+    uint64_t fingerprint;
+    uint32_t nNodes;
+    uint32_t nLinks;
+    uint32_t nAttributes;
+    uint32_t stringsSize;
+  };
+
+  struct NodeRecord {
+    uint32_t name; ///< offset in the string table
+    uint32_t systemId;
+    uint32_t role;
+    uint32_t hasPosition;
+    double posX;
+    double posY;
+  };
+
+  struct LinkRecord {
+    uint32_t fromNode; ///< index in node record array
+    uint32_t toNode;   ///< index in node record array
+    uint32_t firstAttribute;
+    uint32_t nAttributes;
+  };
+
+  struct AttributeRecord {
+    uint32_t key;   ///< offset in the string table
+    uint32_t value; ///< offset in the string table
+  };
+
+public:
+  CompiledTopology();
+
+  /**
+   * \brief Map the compiled topology file into memory
+   *
+   * All node and attribute indices and string offsets are checked, so records and strings of
+   * an opened topology can be accessed without further checks.
+   *
+   * \return false if file does not exist or is not a valid compiled topology
+   */
+  bool
+  Open(const std::string& file);
+
+  bool
+  IsOpen() const;
+
+  void
+  Close();
+
+  const Header&
+  GetHeader() const;
+
+  const NodeRecord&
+  GetNode(uint32_t index) const;
+
+  const LinkRecord&
+  GetLink(uint32_t index) const;
+
+  const AttributeRecord&
+  GetAttribute(uint32_t index) const;
+
+  const char*
+  GetString(uint32_t offset) const;
+
+  /**
+   * \brief Write compiled topology
+   *
+   * \param file output file name
+   * \param fingerprint value that identifies the source of the topology (e.g., hash of the
+   *        text file and reader parameters)
+   * \param nodes nodes in the order they should be recreated
+   * \param roles role of each node (same order as \p nodes), can be empty
+   * \param links links with all their attributes
+   */
+  static void
+  Write(const std::string& file, uint64_t fingerprint, const NodeContainer& nodes,
+        const std::vector<NodeRole>& roles, const std::list<TopologyReader::Link>& links);
+
+  /**
+   * \brief FNV-1a hash that can be used to build a fingerprint of the topology source
+   */
+  static uint64_t
+  Hash(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL);
+
+  static uint64_t
+  Hash(const std::string& data, uint64_t hash = 14695981039346656037ULL);
+
+  /**
+   * \brief Hash content of the file (file is accessed through a memory mapping)
+   */
+  static uint64_t
+  HashFile(const std::string& file, uint64_t hash = 14695981039346656037ULL);
+
+private:
+  /**
+   * \brief Check that records of the mapped file refer only to existing records and strings
+   */
+  bool
+  IsValid() const;
+
+private:
+  boost::iostreams::mapped_file_source m_file;
+  const Header* m_header;
+  const NodeRecord* m_nodes;
+  const LinkRecord* m_links;
+  const AttributeRecord* m_attributes;
+  const char* m_strings;
+};
+
+} // namespace ns3
+
+#endif // COMPILED_TOPOLOGY_H
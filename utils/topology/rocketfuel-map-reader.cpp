@@ -52,6 +52,7 @@
 #include <boost/graph/connected_components.hpp>
 
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 using namespace boost;
@@ -285,8 +286,17 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     return m_nodes;
   }
 
+  // the expression is the same for all lines, compile it only once
+  regex_t regex;
+  int ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0) {
+    regerror(ret, &regex, errbuf, sizeof(errbuf));
+    regfree(&regex);
+    NS_LOG_WARN("Cannot compile regular expression: " << errbuf);
+    return m_nodes;
+  }
+
   while (!topgen.eof()) {
-    int ret;
     int argc;
     char* argv[REGMATCH_MAX];
     char* buf;
@@ -299,19 +309,10 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     buf = (char*)line.c_str();
 
     regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0) {
-      regerror(ret, &regex, errbuf, sizeof(errbuf));
-      regfree(&regex);
-      continue;
-    }
 
     ret = regexec(&regex, buf, REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH) {
       NS_LOG_WARN("match failed (maps file): %s" << buf);
-      regfree(&regex);
       continue;
     }
 
@@ -331,8 +332,8 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
 
     GenerateFromMapsFile(argc, argv);
-    regfree(&regex);
   }
+  regfree(&regex);
 
   if (keepOneComponent) {
     NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
@@ -407,16 +408,19 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
       Names::Rename(nodeName, "bb-" + nodeName);
       put(vertex_name, m_graph, *v, "bb-" + nodeName);
       m_backboneRouters.Add(node);
+      m_nodeRoles[node->GetId()] = CompiledTopology::ROLE_BACKBONE;
       break;
     case CLIENT:
       Names::Rename(nodeName, "leaf-" + nodeName);
       put(vertex_name, m_graph, *v, "leaf-" + nodeName);
       m_customerRouters.Add(node);
+      m_nodeRoles[node->GetId()] = CompiledTopology::ROLE_CUSTOMER;
       break;
     case GATEWAY:
       Names::Rename(nodeName, "gw-" + nodeName);
       put(vertex_name, m_graph, *v, "gw-" + nodeName);
       m_gatewayRouters.Add(node);
+      m_nodeRoles[node->GetId()] = CompiledTopology::ROLE_GATEWAY;
       break;
     case UNKNOWN:
       NS_FATAL_ERROR("Should not happen");
@@ -463,6 +467,66 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
   return m_nodes;
 }
 
+NodeContainer
+RocketfuelMapReader::ReadCached(const std::string& cacheFile, RocketfuelParams params,
+                               bool keepOneComponent /*=true*/, bool connectBackbones /*=true*/)
+{
+  std::ostringstream os;
+  os << params.averageRtt << " " << params.clientNodeDegrees << " " << params.minb2bBandwidth
+     << " " << params.minb2bDelay << " " << params.maxb2bBandwidth << " " << params.maxb2bDelay
+     << " " << params.minb2gBandwidth << " " << params.minb2gDelay << " "
+     << params.maxb2gBandwidth << " " << params.maxb2gDelay << " " << params.ming2cBandwidth
+     << " " << params.ming2cDelay << " " << params.maxg2cBandwidth << " " << params.maxg2cDelay
+     << " " << keepOneComponent << " " << connectBackbones << " " << m_referenceOspfRate;
+
+  uint64_t fingerprint = CompiledTopology::Hash(os.str(), GetSourceFingerprint());
+
+  CompiledTopology compiled;
+  if (compiled.Open(cacheFile) && LoadCompiled(compiled, fingerprint, true)) {
+    NS_LOG_INFO("Topology loaded from compiled cache " << cacheFile);
+    NS_LOG_INFO("Clients:   " << m_customerRouters.GetN());
+    NS_LOG_INFO("Gateways:  " << m_gatewayRouters.GetN());
+    NS_LOG_INFO("Backbones: " << m_backboneRouters.GetN());
+    NS_LOG_INFO("Links:     " << GetLinks().size());
+    return m_nodes;
+  }
+
+  Read(params, keepOneComponent, connectBackbones);
+  SaveCompiled(cacheFile, fingerprint);
+  return m_nodes;
+}
+
+CompiledTopology::NodeRole
+RocketfuelMapReader::GetCompiledNodeRole(Ptr<Node> node) const
+{
+  std::map<uint32_t, CompiledTopology::NodeRole>::const_iterator role =
+    m_nodeRoles.find(node->GetId());
+  if (role == m_nodeRoles.end())
+    return CompiledTopology::ROLE_NONE;
+
+  return role->second;
+}
+
+void
+RocketfuelMapReader::OnCompiledNodeCreated(Ptr<Node> node, CompiledTopology::NodeRole role)
+{
+  m_nodeRoles[node->GetId()] = role;
+
+  switch (role) {
+  case CompiledTopology::ROLE_BACKBONE:
+    m_backboneRouters.Add(node);
+    break;
+  case CompiledTopology::ROLE_CUSTOMER:
+    m_customerRouters.Add(node);
+    break;
+  case CompiledTopology::ROLE_GATEWAY:
+    m_gatewayRouters.Add(node);
+    break;
+  case CompiledTopology::ROLE_NONE:
+    break;
+  }
+}
+
 const NodeContainer&
 RocketfuelMapReader::GetBackboneRouters() const
 {
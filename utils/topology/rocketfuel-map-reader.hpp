@@ -27,6 +27,7 @@
 #include "ns3/net-device-container.h"
 #include "ns3/data-rate.h"
 
+#include <map>
 #include <set>
 #include <boost/graph/adjacency_list.hpp>
 
@@ -109,6 +110,19 @@ public:
   virtual NodeContainer
   Read(RocketfuelParams params, bool keepOneComponent = true, bool connectBackbones = true);
 
+  /**
+   * \brief Read topology using compiled topology cache
+   *
+   * The same as Read (params, keepOneComponent, connectBackbones), but if \p cacheFile
+   * contains topology compiled from the same map file with the same parameters and RNG
+   * seed/run, it is loaded directly (with all sampled link parameters and node roles),
+   * skipping parsing and topology estimation.  Otherwise, the map file is read and the
+   * result is saved to \p cacheFile.
+   */
+  virtual NodeContainer
+  ReadCached(const std::string& cacheFile, RocketfuelParams params, bool keepOneComponent = true,
+             bool connectBackbones = true);
+
   const NodeContainer&
   GetBackboneRouters() const;
 
@@ -124,6 +138,13 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+protected:
+  virtual CompiledTopology::NodeRole
+  GetCompiledNodeRole(Ptr<Node> node) const;
+
+  virtual void
+  OnCompiledNodeCreated(Ptr<Node> node, CompiledTopology::NodeRole role);
+
 private:
   RocketfuelMapReader(const RocketfuelMapReader&);
   RocketfuelMapReader&
@@ -152,6 +173,8 @@ private:
   NodeContainer m_gatewayRouters;
   NodeContainer m_customerRouters;
 
+  std::map<uint32_t, CompiledTopology::NodeRole> m_nodeRoles; ///< node id -> role
+
   typedef boost::adjacency_list_traits<boost::setS, boost::setS, boost::undirectedS> Traits;
 
   enum node_type_t { UNKNOWN = 0, CLIENT = 1, GATEWAY = 2, BACKBONE = 3 };
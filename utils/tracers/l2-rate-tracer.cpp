@@ -47,6 +47,11 @@ L2RateTracer::Destroy()
 void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
+  if (ndn::TraceWriter::IsBinaryFile(file)) {
+    InstallAllBinary(file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L2RateTracer>> tracers;
   std::shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -81,6 +86,33 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
+void
+L2RateTracer::InstallAllBinary(const std::string& file, Time averagingPeriod)
+{
+  using ndn::TraceWriter;
+  auto writer = std::make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+      {"Time", TraceWriter::DOUBLE},
+      {"Node", TraceWriter::STRING},
+      {"Interface", TraceWriter::STRING},
+      {"Type", TraceWriter::STRING},
+      {"Packets", TraceWriter::DOUBLE},
+      {"Kilobytes", TraceWriter::DOUBLE},
+      {"PacketsRaw", TraceWriter::DOUBLE},
+      {"KilobytesRaw", TraceWriter::DOUBLE}});
+  if (!writer->IsOpen()) {
+    return;
+  }
+
+  std::list<Ptr<L2RateTracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<L2RateTracer> trace = Create<L2RateTracer>(writer, *node);
+    trace->SetAveragingPeriod(averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  g_tracers.push_back(std::make_tuple(std::shared_ptr<std::ostream>(), tracers));
+}
+
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L2Tracer(node)
   , m_os(os)
@@ -88,6 +120,13 @@ L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   SetAveragingPeriod(Seconds(1.0));
 }
 
+L2RateTracer::L2RateTracer(std::shared_ptr<ndn::TraceWriter> writer, Ptr<Node> node)
+  : L2Tracer(node)
+  , m_writer(writer)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
 L2RateTracer::~L2RateTracer()
 {
   m_printEvent.Cancel();
@@ -104,7 +143,12 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
@@ -150,18 +194,48 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  PrintRow(output, time, interface, printName, STATS(2).fieldName, STATS(3).fieldName,             \
+           STATS(0).fieldName, STATS(1).fieldName / 1024.0);
 
 void
-L2RateTracer::Print(std::ostream& os) const
+L2RateTracer::PrintRow(std::ostream& os, const Time& time, const char* interface,
+                       const char* type, double packets, double kilobytes, double packetsRaw,
+                       double kilobytesRaw) const
+{
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << type << "\t"
+     << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t" << kilobytesRaw << "\n";
+}
+
+void
+L2RateTracer::PrintRow(ndn::TraceWriter& writer, const Time& time, const char* interface,
+                       const char* type, double packets, double kilobytes, double packetsRaw,
+                       double kilobytesRaw) const
+{
+  writer << time.ToDouble(Time::S) << m_node << interface << type << packets << kilobytes
+         << packetsRaw << kilobytesRaw;
+}
+
+template<class Output>
+void
+L2RateTracer::PrintAll(Output& output) const
 {
   Time time = Simulator::Now();
 
   PRINTER("Drop", m_drop, "combined");
 }
 
+void
+L2RateTracer::Print(std::ostream& os) const
+{
+  PrintAll(os);
+}
+
+void
+L2RateTracer::Write(ndn::TraceWriter& writer) const
+{
+  PrintAll(writer);
+}
+
 void
 L2RateTracer::Drop(Ptr<const Packet> packet)
 {
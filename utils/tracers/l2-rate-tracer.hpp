@@ -21,6 +21,7 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ndn-trace-writer.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -34,6 +35,9 @@ namespace ns3 {
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
  *
+ * If the trace file name ends with ".ndntrace", the trace is written in binary format by
+ * ndn::TraceWriter instead of text.
+ *
  * @todo Finish implementation
  */
 class L2RateTracer : public L2Tracer {
@@ -42,6 +46,11 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor that writes binary trace
+   */
+  L2RateTracer(std::shared_ptr<ndn::TraceWriter> writer, Ptr<Node> node);
   virtual ~L2RateTracer();
 
   /**
@@ -78,18 +87,40 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write the current period to the binary trace
+   */
+  void
+  Write(ndn::TraceWriter& writer) const;
+
   virtual void
   Drop(Ptr<const Packet>);
 
 private:
+  static void
+  InstallAllBinary(const std::string& file, Time averagingPeriod);
+
   void
   PeriodicPrinter();
 
   void
   Reset();
 
+  template<class Output>
+  void
+  PrintAll(Output& output) const;
+
+  void
+  PrintRow(std::ostream& os, const Time& time, const char* interface, const char* type,
+           double packets, double kilobytes, double packetsRaw, double kilobytesRaw) const;
+
+  void
+  PrintRow(ndn::TraceWriter& writer, const Time& time, const char* interface, const char* type,
+           double packets, double kilobytes, double packetsRaw, double kilobytesRaw) const;
+
 private:
   std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceWriter> m_writer;
   Time m_period;
   EventId m_printEvent;
 
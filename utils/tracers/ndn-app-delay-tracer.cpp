@@ -54,6 +54,11 @@ AppDelayTracer::InstallAll(const std::string& file)
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -91,6 +96,11 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(nodes, file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -128,6 +138,11 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer(node), file);
+    return;
+  }
+
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -157,6 +172,110 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
+void
+AppDelayTracer::InstallBinary(const NodeContainer& nodes, const std::string& file)
+{
+  auto writer = make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+      {"Time", TraceWriter::DOUBLE},
+      {"Node", TraceWriter::STRING},
+      {"AppId", TraceWriter::INTEGER},
+      {"SeqNo", TraceWriter::INTEGER},
+      {"Type", TraceWriter::STRING},
+      {"DelayS", TraceWriter::DOUBLE},
+      {"DelayUS", TraceWriter::DOUBLE},
+      {"RetxCount", TraceWriter::INTEGER},
+      {"HopCount", TraceWriter::INTEGER}});
+  if (!writer->IsOpen()) {
+    return;
+  }
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Create<AppDelayTracer>(writer, *node));
+  }
+
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
+void
+AppDelayTracer::InstallAllHistograms(const std::string& file, Time period /* = Seconds(0)*/,
+                                     HistogramAggregation aggregation /* = PER_APP*/)
+{
+  InstallHistograms(NodeContainer::GetGlobal(), file, period, aggregation);
+}
+
+void
+AppDelayTracer::InstallHistograms(const NodeContainer& nodes, const std::string& file,
+                                  Time period /* = Seconds(0)*/,
+                                  HistogramAggregation aggregation /* = PER_APP*/)
+{
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinaryHistograms(nodes, file, period, aggregation);
+    return;
+  }
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->EnableHistograms(period, aggregation);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHistogramHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+AppDelayTracer::InstallBinaryHistograms(const NodeContainer& nodes, const std::string& file,
+                                        Time period, HistogramAggregation aggregation)
+{
+  auto writer = make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+      {"Time", TraceWriter::DOUBLE},
+      {"Node", TraceWriter::STRING},
+      {"AppId", TraceWriter::INTEGER},
+      {"Type", TraceWriter::STRING},
+      {"Count", TraceWriter::INTEGER},
+      {"Min", TraceWriter::INTEGER},
+      {"Mean", TraceWriter::DOUBLE},
+      {"P50", TraceWriter::INTEGER},
+      {"P90", TraceWriter::INTEGER},
+      {"P99", TraceWriter::INTEGER},
+      {"P99.9", TraceWriter::INTEGER},
+      {"Max", TraceWriter::INTEGER}});
+  if (!writer->IsOpen()) {
+    return;
+  }
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(writer, *node);
+    trace->EnableHistograms(period, aggregation);
+    tracers.push_back(trace);
+  }
+
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 Ptr<AppDelayTracer>
 AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 {
@@ -174,6 +293,24 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_useHistograms(false)
+  , m_aggregation(PER_APP)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+  , m_useHistograms(false)
+  , m_aggregation(PER_APP)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +325,22 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_useHistograms(false)
+  , m_aggregation(PER_APP)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+
+  // tracers destroyed before the simulator write the histograms right away
+  if (m_useHistograms && !m_finalPrintEvent.IsExpired()) {
+    m_finalPrintEvent.Cancel();
+    PrintHistograms();
+  }
+}
 
 void
 AppDelayTracer::Connect()
@@ -230,10 +378,141 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+void
+AppDelayTracer::PrintHistogramHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "AppId"
+     << "\t"
+     << "Type"
+     << "\t"
+     << "Count"
+     << "\t"
+     << "Min"
+     << "\t"
+     << "Mean"
+     << "\t"
+     << "P50"
+     << "\t"
+     << "P90"
+     << "\t"
+     << "P99"
+     << "\t"
+     << "P99.9"
+     << "\t"
+     << "Max"
+     << "";
+}
+
+void
+AppDelayTracer::EnableHistograms(Time period, HistogramAggregation aggregation)
+{
+  m_useHistograms = true;
+  m_aggregation = aggregation;
+  m_period = period;
+
+  if (!m_period.IsZero()) {
+    m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicHistogramPrinter, this);
+  }
+  m_finalPrintEvent = Simulator::ScheduleDestroy(&AppDelayTracer::FinalHistogramPrinter, this);
+}
+
+AppDelayTracer::Histograms&
+AppDelayTracer::GetHistograms(Ptr<App> app)
+{
+  return m_histograms[m_aggregation == PER_APP ? static_cast<int32_t>(app->GetId()) : -1];
+}
+
+void
+AppDelayTracer::PeriodicHistogramPrinter()
+{
+  PrintHistograms();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicHistogramPrinter, this);
+}
+
+void
+AppDelayTracer::FinalHistogramPrinter()
+{
+  m_printEvent.Cancel();
+  PrintHistograms();
+}
+
+void
+AppDelayTracer::PrintHistograms()
+{
+  if (m_writer != nullptr) {
+    PrintHistograms(*m_writer);
+  }
+  else {
+    PrintHistograms(*m_os);
+  }
+}
+
+template<class Output>
+void
+AppDelayTracer::PrintHistograms(Output& output)
+{
+  Time time = Simulator::Now();
+  for (auto& histograms : m_histograms) {
+    PrintHistogramRow(output, time, histograms.first, "LastDelay", histograms.second.lastDelay);
+    PrintHistogramRow(output, time, histograms.first, "FullDelay", histograms.second.fullDelay);
+    PrintHistogramRow(output, time, histograms.first, "HopCount", histograms.second.hopCount);
+
+    histograms.second.lastDelay.Reset();
+    histograms.second.fullDelay.Reset();
+    histograms.second.hopCount.Reset();
+  }
+}
+
+void
+AppDelayTracer::PrintHistogramRow(std::ostream& os, const Time& time, int32_t appId,
+                                  const char* type, const LogHistogram& histogram) const
+{
+  if (histogram.GetCount() == 0) {
+    return;
+  }
+
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << appId << "\t" << type << "\t"
+     << histogram.GetCount() << "\t" << histogram.GetMin() << "\t" << histogram.GetMean() << "\t"
+     << histogram.GetPercentile(50) << "\t" << histogram.GetPercentile(90) << "\t"
+     << histogram.GetPercentile(99) << "\t" << histogram.GetPercentile(99.9) << "\t"
+     << histogram.GetMax() << "\n";
+}
+
+void
+AppDelayTracer::PrintHistogramRow(TraceWriter& writer, const Time& time, int32_t appId,
+                                  const char* type, const LogHistogram& histogram) const
+{
+  if (histogram.GetCount() == 0) {
+    return;
+  }
+
+  writer << time.ToDouble(Time::S) << m_node << appId << type << histogram.GetCount()
+         << histogram.GetMin() << histogram.GetMean() << histogram.GetPercentile(50)
+         << histogram.GetPercentile(90) << histogram.GetPercentile(99)
+         << histogram.GetPercentile(99.9) << histogram.GetMax();
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_useHistograms) {
+    GetHistograms(app).lastDelay.Record(delay.GetMicroSeconds());
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    *m_writer << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno
+              << "LastDelay" << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << 1
+              << hopCount;
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +524,23 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_useHistograms) {
+    // both delay traces fire for the same Data, so the hop count is recorded only here
+    Histograms& histograms = GetHistograms(app);
+    histograms.fullDelay.Record(delay.GetMicroSeconds());
+    if (hopCount >= 0) {
+      histograms.hopCount.Record(hopCount);
+    }
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    *m_writer << Simulator::Now().ToDouble(Time::S) << m_node << app->GetId() << seqno
+              << "FullDelay" << delay.ToDouble(Time::S) << delay.ToDouble(Time::US) << retxCount
+              << hopCount;
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -22,6 +22,9 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-writer.hpp"
+#include "ndn-log-histogram.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +33,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -43,9 +47,25 @@ class App;
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * If the trace file name ends with ".ndntrace", the trace is written in binary format by
+ * TraceWriter instead of text.
+ *
+ * Tracers installed with InstallAllHistograms or InstallHistograms do not write a row per
+ * received Data.  Instead, delays (in microseconds) and hop counts are recorded in
+ * LogHistogram's of every application (or every node), and only count, minimum, mean,
+ * percentiles, and maximum are written, periodically and/or when the simulation ends.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
+  /**
+   * @brief Granularity of the histograms in the histogram mode
+   */
+  enum HistogramAggregation {
+    PER_APP, ///< histograms of every application
+    PER_NODE ///< histograms of all applications on the node (AppId in the trace is -1)
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
@@ -91,6 +111,34 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install histogram tracers on all simulation nodes
+   *
+   * @param file File to which histograms will be written.  If filename is -, then std::out is
+   *        used
+   * @param period How often histograms will be written into the trace file and reset.  If
+   *        zero, histograms cover the whole simulation and are written only when the
+   *        simulation is destroyed (or the tracers are destroyed, whatever happens first)
+   * @param aggregation Keep histograms per application or per node
+   */
+  static void
+  InstallAllHistograms(const std::string& file, Time period = Seconds(0),
+                       HistogramAggregation aggregation = PER_APP);
+
+  /**
+   * @brief Helper method to install histogram tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which histograms will be written.  If filename is -, then std::out is
+   *        used
+   * @param period How often histograms will be written into the trace file and reset (see
+   *        InstallAllHistograms)
+   * @param aggregation Keep histograms per application or per node
+   */
+  static void
+  InstallHistograms(const NodeContainer& nodes, const std::string& file, Time period = Seconds(0),
+                    HistogramAggregation aggregation = PER_APP);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -114,6 +162,14 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node and writes binary
+   *        trace
+   * @param writer binary trace writer, shared by tracers of all nodes
+   * @param node   pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -127,10 +183,64 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Print head of the histogram trace
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHistogramHeader(std::ostream& os) const;
+
 private:
+  static void
+  InstallBinary(const NodeContainer& nodes, const std::string& file);
+
+  static void
+  InstallBinaryHistograms(const NodeContainer& nodes, const std::string& file, Time period,
+                          HistogramAggregation aggregation);
+
   void
   Connect();
 
+  /**
+   * @brief Switch the tracer to the histogram mode
+   */
+  void
+  EnableHistograms(Time period, HistogramAggregation aggregation);
+
+  struct Histograms {
+    LogHistogram lastDelay; ///< microseconds
+    LogHistogram fullDelay; ///< microseconds
+    LogHistogram hopCount;
+  };
+
+  Histograms&
+  GetHistograms(Ptr<App> app);
+
+  void
+  PeriodicHistogramPrinter();
+
+  void
+  FinalHistogramPrinter();
+
+  /**
+   * @brief Write non-empty histograms to the trace and reset them
+   */
+  void
+  PrintHistograms();
+
+  template<class Output>
+  void
+  PrintHistograms(Output& output);
+
+  void
+  PrintHistogramRow(std::ostream& os, const Time& time, int32_t appId, const char* type,
+                    const LogHistogram& histogram) const;
+
+  void
+  PrintHistogramRow(TraceWriter& writer, const Time& time, int32_t appId, const char* type,
+                    const LogHistogram& histogram) const;
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +253,14 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer;
+
+  bool m_useHistograms;
+  HistogramAggregation m_aggregation;
+  Time m_period;
+  std::map<int32_t, Histograms> m_histograms; ///< histograms by AppId (-1 for PER_NODE)
+  EventId m_printEvent;
+  EventId m_finalPrintEvent;
 };
 
 } // namespace ndn
@@ -53,6 +53,11 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -91,6 +96,11 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(nodes, file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -129,6 +139,11 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer(node), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -158,6 +173,28 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
+void
+CsTracer::InstallBinary(const NodeContainer& nodes, const std::string& file, Time averagingPeriod)
+{
+  auto writer = make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+      {"Time", TraceWriter::DOUBLE},
+      {"Node", TraceWriter::STRING},
+      {"Type", TraceWriter::STRING},
+      {"Packets", TraceWriter::DOUBLE}});
+  if (!writer->IsOpen()) {
+    return;
+  }
+
+  std::list<Ptr<CsTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<CsTracer> trace = Create<CsTracer>(writer, *node);
+    trace->SetAveragingPeriod(averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
@@ -188,6 +225,20 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
+CsTracer::CsTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
@@ -218,7 +269,12 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -258,6 +314,15 @@ CsTracer::Print(std::ostream& os) const
   PRINTER("CacheMisses", m_cacheMisses);
 }
 
+void
+CsTracer::Write(TraceWriter& writer) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  writer << time << m_node << "CacheHits" << m_stats.m_cacheHits;
+  writer << time << m_node << "CacheMisses" << m_stats.m_cacheMisses;
+}
+
 void
 CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
 {
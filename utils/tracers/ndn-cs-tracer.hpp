@@ -22,6 +22,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-writer.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -58,6 +60,9 @@ struct Stats {
 /**
  * @ingroup ndn-tracers
  * @brief NDN tracer for cache performance (hits and misses)
+ *
+ * If the trace file name ends with ".ndntrace", the trace is written in binary format by
+ * TraceWriter instead of text.
  */
 class CsTracer : public SimpleRefCount<CsTracer> {
 public:
@@ -147,6 +152,13 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node and writes binary trace
+   * @param writer binary trace writer, shared by tracers of all nodes
+   * @param node   pointer to the node
+   */
+  CsTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,7 +180,16 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data to the binary trace
+   */
+  void
+  Write(TraceWriter& writer) const;
+
 private:
+  static void
+  InstallBinary(const NodeContainer& nodes, const std::string& file, Time averagingPeriod);
+
   void
   Connect();
 
@@ -193,6 +214,7 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer;
 
   Time m_period;
   EventId m_printEvent;
@@ -48,6 +48,11 @@ L3RateTracer::Destroy()
 void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer::GetGlobal(), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -86,6 +91,11 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(nodes, file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -124,6 +134,11 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace boost;
   using namespace std;
 
+  if (TraceWriter::IsBinaryFile(file)) {
+    InstallBinary(NodeContainer(node), file, averagingPeriod);
+    return;
+  }
+
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
@@ -153,6 +168,34 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
+void
+L3RateTracer::InstallBinary(const NodeContainer& nodes, const std::string& file,
+                            Time averagingPeriod)
+{
+  auto writer = make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+      {"Time", TraceWriter::DOUBLE},
+      {"Node", TraceWriter::STRING},
+      {"FaceId", TraceWriter::INTEGER},
+      {"FaceDescr", TraceWriter::STRING},
+      {"Type", TraceWriter::STRING},
+      {"Packets", TraceWriter::DOUBLE},
+      {"Kilobytes", TraceWriter::DOUBLE},
+      {"PacketRaw", TraceWriter::DOUBLE},
+      {"KilobytesRaw", TraceWriter::DOUBLE}});
+  if (!writer->IsOpen()) {
+    return;
+  }
+
+  std::list<Ptr<L3RateTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3RateTracer> trace = Create<L3RateTracer>(writer, *node);
+    trace->SetAveragingPeriod(averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+}
+
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
@@ -172,6 +215,13 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   SetAveragingPeriod(Seconds(1.0));
 }
 
+L3RateTracer::L3RateTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_writer(writer)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
@@ -195,7 +245,12 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -229,131 +284,211 @@ void
 L3RateTracer::Reset()
 {
   for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+    stats.packets.Reset();
+    stats.bytes.Reset();
+  }
+
+  for (auto& stats : m_reservedStats) {
+    stats.second.packets.Reset();
+    stats.second.bytes.Reset();
   }
+
+  m_totalStats.packets.Reset();
+  m_totalStats.bytes.Reset();
 }
 
-const double alpha = 0.8;
+L3RateTracer::FaceStats&
+L3RateTracer::GetStats(const Face& face)
+{
+  nfd::FaceId id = face.getId();
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
+  FaceStats* stats;
+  if (id > nfd::FACEID_RESERVED_MAX) {
+    size_t index = id - nfd::FACEID_RESERVED_MAX - 1;
+    if (index >= m_stats.size()) {
+      m_stats.resize(index + 1);
+    }
+    stats = &m_stats[index];
+  }
+  else {
+    stats = &m_reservedStats[id];
+  }
+
+  if (!stats->isUsed) {
+    stats->isUsed = true;
+    stats->face = face.shared_from_this();
+  }
+  return *stats;
+}
+
+const double alpha = 0.8;
 
 #define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  stats.packetRate.fieldName =                                                                     \
+    /*new value*/ alpha * stats.packets.fieldName / period                                         \
+    + /*old value*/ (1 - alpha) * stats.packetRate.fieldName;                                      \
+  stats.kilobyteRate.fieldName =                                                                   \
+    /*new value*/ alpha * stats.bytes.fieldName / period / 1024.0                                  \
+    + /*old value*/ (1 - alpha) * stats.kilobyteRate.fieldName;                                    \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nullptr) {                                                                    \
-    os << stats.first->getId() << "\t" << stats.first->getLocalUri() << "\t";                      \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  PrintRow(output, time, stats, printName, stats.packetRate.fieldName,                             \
+           stats.kilobyteRate.fieldName, stats.packets.fieldName, stats.bytes.fieldName / 1024.0);
 
 void
-L3RateTracer::Print(std::ostream& os) const
+L3RateTracer::PrintRow(std::ostream& os, const Time& time, const FaceStats& stats,
+                       const char* type, double packets, double kilobytes, double packetsRaw,
+                       double kilobytesRaw) const
 {
-  Time time = Simulator::Now();
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+  if (stats.face != nullptr) {
+    os << stats.face->getId() << "\t" << stats.face->getLocalUri() << "\t";
+  }
+  else {
+    os << "-1\tall\t";
+  }
+  os << type << "\t" << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t" << kilobytesRaw
+     << "\n";
+}
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nullptr)
-      continue;
+void
+L3RateTracer::PrintRow(TraceWriter& writer, const Time& time, const FaceStats& stats,
+                       const char* type, double packets, double kilobytes, double packetsRaw,
+                       double kilobytesRaw) const
+{
+  writer << time.ToDouble(Time::S) << m_node;
+  if (stats.face != nullptr) {
+    writer << stats.face->getId() << stats.face->getLocalUri().toString();
+  }
+  else {
+    writer << -1 << "all";
+  }
+  writer << type << packets << kilobytes << packetsRaw << kilobytesRaw;
+}
+
+template<class Output>
+void
+L3RateTracer::PrintStats(Output& output, const Time& time, FaceStats& stats) const
+{
+  double period = m_period.ToDouble(Time::S);
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+  PRINTER("InInterests", m_inInterests);
+  PRINTER("OutInterests", m_outInterests);
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+  PRINTER("InData", m_inData);
+  PRINTER("OutData", m_outData);
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+  PRINTER("InSatisfiedInterests", m_satisfiedInterests);
+  PRINTER("InTimedOutInterests", m_timedOutInterests);
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+  PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
+  PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+}
+
+template<class Output>
+void
+L3RateTracer::PrintAll(Output& output) const
+{
+  Time time = Simulator::Now();
+
+  for (auto& stats : m_reservedStats) {
+    PrintStats(output, time, stats.second);
   }
 
-  {
-    auto i = m_stats.find(nullptr);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+  for (auto& stats : m_stats) {
+    if (stats.isUsed) {
+      PrintStats(output, time, stats);
     }
   }
+
+  if (m_totalStats.isUsed) {
+    double period = m_period.ToDouble(Time::S);
+    FaceStats& stats = m_totalStats;
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
+  }
+}
+
+void
+L3RateTracer::Print(std::ostream& os) const
+{
+  PrintAll(os);
+}
+
+void
+L3RateTracer::Write(TraceWriter& writer) const
+{
+  PrintAll(writer);
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_outData +=
-      data.wireEncode().size();
+    stats.bytes.m_outData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.shared_from_this()]).m_inData +=
-      data.wireEncode().size();
+    stats.bytes.m_inData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nullptr]).m_satisfiedInterests++;
+  m_totalStats.isUsed = true;
+  m_totalStats.packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_satisfiedInterests ++;
+    GetStats(*in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outSatisfiedInterests ++;
+    GetStats(*out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nullptr]).m_timedOutInterests++;
+  m_totalStats.isUsed = true;
+  m_totalStats.packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_timedOutInterests++;
+    GetStats(*in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outTimedOutInterests++;
+    GetStats(*out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
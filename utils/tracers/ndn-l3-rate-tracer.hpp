@@ -23,14 +23,15 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-trace-writer.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -38,6 +39,13 @@ namespace ndn {
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Counters are kept in a dense array indexed by FaceId (face IDs are assigned sequentially on
+ * each node), so a traced packet costs one array access.  Rates and their exponentially
+ * weighted averages are computed once per averaging period, when the counters are printed.
+ *
+ * If the trace file name ends with ".ndntrace", the trace is written in binary format by
+ * TraceWriter instead of text.
  */
 class L3RateTracer : public L3Tracer {
 public:
@@ -97,6 +105,13 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node and writes binary trace
+   * @param writer binary trace writer, shared by tracers of all nodes
+   * @param node   pointer to the node
+   */
+  L3RateTracer(shared_ptr<TraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -125,6 +140,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write the current period to the binary trace
+   */
+  void
+  Write(TraceWriter& writer) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -146,6 +167,9 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  static void
+  InstallBinary(const NodeContainer& nodes, const std::string& file, Time averagingPeriod);
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -155,12 +179,52 @@ private:
   void
   Reset();
 
+  struct FaceStats {
+    FaceStats()
+      : isUsed(false)
+    {
+      packets.Reset();
+      bytes.Reset();
+      packetRate.Reset();
+      kilobyteRate.Reset();
+    }
+
+    bool isUsed;
+    shared_ptr<const Face> face; ///< nullptr for the node totals
+    Stats packets;               ///< packets in the current period
+    Stats bytes;                 ///< bytes in the current period
+    Stats packetRate;            ///< averaged packet rate
+    Stats kilobyteRate;          ///< averaged kilobyte rate
+  };
+
+  FaceStats&
+  GetStats(const Face& face);
+
+  template<class Output>
+  void
+  PrintAll(Output& output) const;
+
+  template<class Output>
+  void
+  PrintStats(Output& output, const Time& time, FaceStats& stats) const;
+
+  void
+  PrintRow(std::ostream& os, const Time& time, const FaceStats& stats, const char* type,
+           double packets, double kilobytes, double packetsRaw, double kilobytesRaw) const;
+
+  void
+  PrintRow(TraceWriter& writer, const Time& time, const FaceStats& stats, const char* type,
+           double packets, double kilobytes, double packetsRaw, double kilobytesRaw) const;
+
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<shared_ptr<const Face>, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
+  mutable std::vector<FaceStats> m_stats; ///< indexed by FaceId - FACEID_RESERVED_MAX - 1
+  mutable std::map<nfd::FaceId, FaceStats> m_reservedStats; ///< faces with reserved FaceIds
+  mutable FaceStats m_totalStats;
 };
 
 } // namespace ndn
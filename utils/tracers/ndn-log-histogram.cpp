@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-histogram.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+LogHistogram::LogHistogram(uint32_t precisionBits)
+  : m_precisionBits(precisionBits)
+  , m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+  , m_sum(0)
+{
+  NS_ASSERT(precisionBits >= 2 && precisionBits <= 16);
+}
+
+// Buckets [0, 2^P) hold single values.  Value v >= 2^P with the highest bit at position
+// msb >= P is shifted right by (msb - P + 1), which leaves a mantissa in [2^(P-1), 2^P);
+// every shift amount gets 2^(P-1) buckets, one per mantissa.
+size_t
+LogHistogram::GetIndex(uint64_t value) const
+{
+  uint64_t subBuckets = uint64_t(1) << m_precisionBits;
+  if (value < subBuckets) {
+    return value;
+  }
+
+  uint32_t msb = 63 - __builtin_clzll(value);
+  uint32_t shift = msb - m_precisionBits + 1;
+  uint64_t halfBuckets = subBuckets >> 1;
+  return subBuckets + (shift - 1) * halfBuckets + ((value >> shift) - halfBuckets);
+}
+
+uint64_t
+LogHistogram::GetHighestValue(size_t index) const
+{
+  uint64_t subBuckets = uint64_t(1) << m_precisionBits;
+  if (index < subBuckets) {
+    return index;
+  }
+
+  uint64_t halfBuckets = subBuckets >> 1;
+  uint32_t shift = (index - subBuckets) / halfBuckets + 1;
+  uint64_t mantissa = (index - subBuckets) % halfBuckets + halfBuckets;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void
+LogHistogram::Record(uint64_t value)
+{
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  m_counts[index]++;
+
+  m_count++;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += value;
+}
+
+void
+LogHistogram::Merge(const LogHistogram& other)
+{
+  NS_ASSERT(m_precisionBits == other.m_precisionBits);
+
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_counts.size(); i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+
+  m_count += other.m_count;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+void
+LogHistogram::Reset()
+{
+  // keep the allocated buckets, the next period will most likely need them again
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint64_t
+LogHistogram::GetCount() const
+{
+  return m_count;
+}
+
+uint64_t
+LogHistogram::GetMin() const
+{
+  return m_count > 0 ? m_min : 0;
+}
+
+uint64_t
+LogHistogram::GetMax() const
+{
+  return m_max;
+}
+
+double
+LogHistogram::GetMean() const
+{
+  return m_count > 0 ? m_sum / m_count : 0;
+}
+
+uint64_t
+LogHistogram::GetPercentile(double percentile) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return std::min(std::max(GetHighestValue(i), GetMin()), m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
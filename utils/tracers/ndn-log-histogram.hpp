@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOG_HISTOGRAM_H
+#define NDN_LOG_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integer samples with logarithmically sized buckets
+ *
+ * Values below 2^PrecisionBits are counted exactly.  Above that, each power-of-two range is
+ * split into 2^(PrecisionBits - 1) equal buckets (as in HDR histograms), so a value reported
+ * for a percentile differs from the actual sample by less than 2^-(PrecisionBits - 1) of the
+ * sample.  Count, minimum, maximum, and mean are exact.
+ *
+ * Buckets are allocated up to the largest recorded value only, so a histogram of delays in
+ * microseconds below one second takes about 14 KB with the default precision.
+ */
+class LogHistogram {
+public:
+  /**
+   * @param precisionBits number of significant bits kept for each sample (between 2 and 16)
+   */
+  explicit LogHistogram(uint32_t precisionBits = 8);
+
+  void
+  Record(uint64_t value);
+
+  /**
+   * @brief Add all samples of @p other (must have the same precision)
+   */
+  void
+  Merge(const LogHistogram& other);
+
+  /**
+   * @brief Remove all samples
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const;
+
+  /**
+   * @brief Smallest recorded sample (0 if the histogram is empty)
+   */
+  uint64_t
+  GetMin() const;
+
+  /**
+   * @brief Largest recorded sample (0 if the histogram is empty)
+   */
+  uint64_t
+  GetMax() const;
+
+  double
+  GetMean() const;
+
+  /**
+   * @brief Get the value at the given percentile (0..100) of the recorded samples
+   *
+   * The returned value is the largest value that falls into the same bucket as the sample at
+   * the percentile rank, limited to the range of the recorded samples.
+   */
+  uint64_t
+  GetPercentile(double percentile) const;
+
+private:
+  size_t
+  GetIndex(uint64_t value) const;
+
+  uint64_t
+  GetHighestValue(size_t index) const;
+
+private:
+  uint32_t m_precisionBits;
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_HISTOGRAM_H
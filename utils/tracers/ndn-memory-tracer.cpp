@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-memory-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <unistd.h>
+
+#include "utils/mem-usage.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemoryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<MemoryTracer>>>>
+  g_tracers;
+
+void
+MemoryTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+MemoryTracer::InstallAll(const std::string& file, Time period /* = Seconds(1.0)*/)
+{
+  Install(NodeContainer::GetGlobal(), file, period);
+}
+
+void
+MemoryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time period /* = Seconds(1.0)*/)
+{
+  std::list<Ptr<MemoryTracer>> tracers;
+
+  if (TraceWriter::IsBinaryFile(file)) {
+    auto writer = make_shared<TraceWriter>(file, std::vector<TraceWriter::Column>{
+        {"Time", TraceWriter::DOUBLE},
+        {"Node", TraceWriter::STRING},
+        {"Table", TraceWriter::STRING},
+        {"Entries", TraceWriter::INTEGER},
+        {"Bytes", TraceWriter::INTEGER}});
+    if (!writer->IsOpen()) {
+      return;
+    }
+
+    tracers.push_back(Create<MemoryTracer>(writer, nodes, period));
+    g_tracers.push_back(std::make_tuple(shared_ptr<std::ostream>(), tracers));
+    return;
+  }
+
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  tracers.push_back(Create<MemoryTracer>(outputStream, nodes, period));
+  tracers.front()->PrintHeader(*outputStream);
+  *outputStream << "\n";
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string>
+GetNodeNames(const NodeContainer& nodes)
+{
+  std::vector<std::string> names;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    std::string name = Names::FindName(*node);
+    names.push_back(name.empty() ? boost::lexical_cast<std::string>((*node)->GetId()) : name);
+  }
+  return names;
+}
+
+MemoryTracer::MemoryTracer(shared_ptr<std::ostream> os, const NodeContainer& nodes, Time period)
+  : m_nodes(nodes)
+  , m_nodeNames(GetNodeNames(nodes))
+  , m_os(os)
+  , m_period(period)
+{
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+MemoryTracer::MemoryTracer(shared_ptr<TraceWriter> writer, const NodeContainer& nodes,
+                           Time period)
+  : m_nodes(nodes)
+  , m_nodeNames(GetNodeNames(nodes))
+  , m_writer(writer)
+  , m_period(period)
+{
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+MemoryTracer::~MemoryTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+MemoryTracer::PeriodicPrinter()
+{
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+MemoryTracer::NodeUsage
+MemoryTracer::GetUsage(Ptr<Node> node)
+{
+  NodeUsage usage;
+  usage.fill(Usage{0, 0});
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  if (l3 != nullptr) {
+    nfd::Forwarder& forwarder = *l3->getForwarder();
+    usage[NAME_TREE] = {forwarder.getNameTree().size(), forwarder.getNameTree().getMemoryUsage()};
+    usage[FIB] = {forwarder.getFib().size(), forwarder.getFib().getMemoryUsage()};
+    usage[PIT] = {forwarder.getPit().size(), forwarder.getPit().getMemoryUsage()};
+    usage[CS] = {forwarder.getCs().size(), forwarder.getCs().getMemoryUsage()};
+    usage[MEASUREMENTS] = {forwarder.getMeasurements().size(),
+                           forwarder.getMeasurements().getMemoryUsage()};
+    usage[DEAD_NONCE_LIST] = {forwarder.getDeadNonceList().size(),
+                              forwarder.getDeadNonceList().getMemoryUsage()};
+    usage[SIT_NAME_TREE] = {forwarder.getSitNameTree().size(),
+                            forwarder.getSitNameTree().getMemoryUsage()};
+    usage[SIT] = {forwarder.getSit().size(), forwarder.getSit().getMemoryUsage()};
+  }
+
+  Ptr<ContentStore> cs = node->GetObject<ContentStore>();
+  if (cs != nullptr) {
+    usage[CONTENT_STORE] = {cs->GetSize(), cs->GetMemoryUsage()};
+  }
+
+  return usage;
+}
+
+const char*
+MemoryTracer::GetTableName(Table table)
+{
+  switch (table) {
+  case NAME_TREE:
+    return "NameTree";
+  case FIB:
+    return "Fib";
+  case PIT:
+    return "Pit";
+  case CS:
+    return "Cs";
+  case MEASUREMENTS:
+    return "Measurements";
+  case DEAD_NONCE_LIST:
+    return "DeadNonceList";
+  case SIT_NAME_TREE:
+    return "SitNameTree";
+  case SIT:
+    return "Sit";
+  case CONTENT_STORE:
+    return "ContentStore";
+  default:
+    return "Unknown";
+  }
+}
+
+void
+MemoryTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "Bytes";
+}
+
+void
+MemoryTracer::PrintRow(std::ostream& os, const Time& time, const std::string& node,
+                       const char* table, uint64_t nEntries, uint64_t nBytes) const
+{
+  os << time.ToDouble(Time::S) << "\t" << node << "\t" << table << "\t" << nEntries << "\t"
+     << nBytes << "\n";
+}
+
+void
+MemoryTracer::PrintRow(TraceWriter& writer, const Time& time, const std::string& node,
+                       const char* table, uint64_t nEntries, uint64_t nBytes) const
+{
+  writer << time.ToDouble(Time::S) << node << table << nEntries << nBytes;
+}
+
+template<class Output>
+void
+MemoryTracer::PrintUsage(Output& output, const Time& time, const std::string& node,
+                         const NodeUsage& usage) const
+{
+  Usage total = {0, 0};
+  for (int table = 0; table < N_TABLES; table++) {
+    PrintRow(output, time, node, GetTableName(static_cast<Table>(table)), usage[table].nEntries,
+             usage[table].nBytes);
+    total.nEntries += usage[table].nEntries;
+    total.nBytes += usage[table].nBytes;
+  }
+  PrintRow(output, time, node, "Total", total.nEntries, total.nBytes);
+}
+
+template<class Output>
+void
+MemoryTracer::PrintAll(Output& output) const
+{
+  Time time = Simulator::Now();
+
+  NodeUsage network;
+  network.fill(Usage{0, 0});
+  for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+    NodeUsage usage = GetUsage(m_nodes.Get(i));
+    PrintUsage(output, time, m_nodeNames[i], usage);
+
+    for (int table = 0; table < N_TABLES; table++) {
+      network[table].nEntries += usage[table].nEntries;
+      network[table].nBytes += usage[table].nBytes;
+    }
+  }
+
+  PrintUsage(output, time, "all", network);
+
+  int64_t rss = MemUsage::Get();
+  PrintRow(output, time, "all", "ProcessRss", 0, rss > 0 ? rss : 0);
+}
+
+void
+MemoryTracer::Print(std::ostream& os) const
+{
+  PrintAll(os);
+}
+
+void
+MemoryTracer::Write(TraceWriter& writer) const
+{
+  PrintAll(writer);
+}
+
+} // namespace ndn
+} // namespace ns3
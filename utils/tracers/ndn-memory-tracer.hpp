@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MEMORY_TRACER_H
+#define NDN_MEMORY_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-trace-writer.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <array>
+#include <tuple>
+#include <list>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of the approximate memory taken by forwarding tables
+ *
+ * Every period, the tracer samples the byte counts that NFD tables (NameTree, FIB, PIT, CS,
+ * Measurements, Dead Nonce List, SIT and its NameTree) and the ndnSIM content store keep
+ * up to date on insert and erase (see nfd::memory_usage), so sampling does not enumerate the
+ * tables.  For every node, the trace has one row per table and a Total row; rows with Node
+ * "all" sum the tables over all traced nodes and add the resident set size of the simulator
+ * process (ProcessRss, see MemUsage) for comparison.
+ *
+ * If the trace file name ends with ".ndntrace", the trace is written in binary format by
+ * TraceWriter instead of text.
+ */
+class MemoryTracer : public SimpleRefCount<MemoryTracer> {
+public:
+  enum Table {
+    NAME_TREE,
+    FIB,
+    PIT,
+    CS,
+    MEASUREMENTS,
+    DEAD_NONCE_LIST,
+    SIT_NAME_TREE,
+    SIT,
+    CONTENT_STORE, ///< ndnSIM content store (if enabled)
+    N_TABLES
+  };
+
+  struct Usage {
+    uint64_t nEntries;
+    uint64_t nBytes;
+  };
+
+  typedef std::array<Usage, N_TABLES> NodeUsage;
+
+  /**
+   * @brief Helper method to install tracer of all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often memory usage will be sampled and written into the trace file
+   *        (default, every second)
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracer of the selected simulation nodes
+   *
+   * @param nodes Nodes which tables are traced (the "all" rows sum only these nodes)
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often memory usage will be sampled and written into the trace file
+   *        (default, every second)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor
+   * @param os     reference to the output stream
+   * @param nodes  traced nodes
+   * @param period sampling period
+   */
+  MemoryTracer(shared_ptr<std::ostream> os, const NodeContainer& nodes, Time period);
+
+  /**
+   * @brief Trace constructor that writes binary trace
+   * @param writer binary trace writer
+   * @param nodes  traced nodes
+   * @param period sampling period
+   */
+  MemoryTracer(shared_ptr<TraceWriter> writer, const NodeContainer& nodes, Time period);
+
+  /**
+   * @brief Destructor
+   */
+  ~MemoryTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print current memory usage
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Write current memory usage to the binary trace
+   */
+  void
+  Write(TraceWriter& writer) const;
+
+  /**
+   * @brief Get approximate memory usage of the tables on the node
+   *
+   * All counts are zero if NDN stack is not installed on the node.
+   */
+  static NodeUsage
+  GetUsage(Ptr<Node> node);
+
+  /**
+   * @brief Get name of the table, as it appears in the trace
+   */
+  static const char*
+  GetTableName(Table table);
+
+private:
+  void
+  PeriodicPrinter();
+
+  template<class Output>
+  void
+  PrintAll(Output& output) const;
+
+  template<class Output>
+  void
+  PrintUsage(Output& output, const Time& time, const std::string& node,
+             const NodeUsage& usage) const;
+
+  void
+  PrintRow(std::ostream& os, const Time& time, const std::string& node, const char* table,
+           uint64_t nEntries, uint64_t nBytes) const;
+
+  void
+  PrintRow(TraceWriter& writer, const Time& time, const std::string& node, const char* table,
+           uint64_t nEntries, uint64_t nBytes) const;
+
+private:
+  NodeContainer m_nodes;
+  std::vector<std::string> m_nodeNames;
+
+  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer;
+
+  Time m_period;
+  EventId m_printEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEMORY_TRACER_H
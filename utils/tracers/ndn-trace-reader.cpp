@@ -0,0 +1,378 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-reader.hpp"
+
+#include "ns3/log.h"
+
+#include <cstring>
+#include <ostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceReader");
+
+namespace ns3 {
+namespace ndn {
+
+static bool
+readNumber(std::istream& is, uint64_t& value, size_t size)
+{
+  value = 0;
+  for (size_t i = 0; i < size; i++) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0xFF) << (8 * i);
+  }
+  return true;
+}
+
+static bool
+readVarNumber(const std::vector<uint8_t>& data, size_t& offset, uint64_t& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64 && offset < data.size(); shift += 7) {
+    uint8_t byte = data[offset++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool
+unpackIntegers(const std::vector<uint8_t>& data, size_t nRows, std::vector<uint64_t>& values)
+{
+  size_t offset = 0;
+  int64_t previous = 0;
+  for (size_t row = 0; row < nRows; row++) {
+    uint64_t zigzag;
+    if (!readVarNumber(data, offset, zigzag)) {
+      return false;
+    }
+    int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    previous = static_cast<int64_t>(static_cast<uint64_t>(previous) + delta);
+    values[row] = static_cast<uint64_t>(previous);
+  }
+  return offset == data.size();
+}
+
+static bool
+unpackDoubles(const std::vector<uint8_t>& data, size_t nRows, std::vector<uint64_t>& values)
+{
+  size_t offset = 0;
+  uint64_t previous = 0;
+  for (size_t row = 0; row < nRows; row++) {
+    if (offset >= data.size()) {
+      return false;
+    }
+    int leading = data[offset] >> 4;
+    int trailing = data[offset] & 0x0F;
+    offset++;
+
+    uint64_t x = 0;
+    if (leading < 8) {
+      if (leading + trailing > 7 || offset + 8 - leading - trailing > data.size()) {
+        return false;
+      }
+      for (int byte = 7 - leading; byte >= trailing; byte--) {
+        x |= static_cast<uint64_t>(data[offset++]) << (8 * byte);
+      }
+    }
+
+    previous ^= x;
+    values[row] = previous;
+  }
+  return offset == data.size();
+}
+
+template<class T>
+static bool
+unpackRaw(const std::vector<uint8_t>& data, size_t nRows, std::vector<uint64_t>& values)
+{
+  if (data.size() != nRows * sizeof(T)) {
+    return false;
+  }
+  for (size_t row = 0; row < nRows; row++) {
+    T value;
+    std::memcpy(&value, &data[row * sizeof(T)], sizeof(T));
+    values[row] = static_cast<uint64_t>(value);
+  }
+  return true;
+}
+
+TraceReader::TraceReader()
+  : m_nRows(0)
+  , m_row(0)
+  , m_isCorrupted(false)
+{
+}
+
+bool
+TraceReader::Open(const std::string& file)
+{
+  m_is.open(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!m_is.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for reading");
+    return false;
+  }
+
+  char magic[sizeof(TraceWriter::MAGIC)];
+  uint64_t version = 0;
+  uint64_t nColumns = 0;
+  if (!m_is.read(magic, sizeof(magic))
+      || std::memcmp(magic, TraceWriter::MAGIC, sizeof(magic)) != 0
+      || !readNumber(m_is, version, 4) || version != TraceWriter::FORMAT_VERSION
+      || !readNumber(m_is, nColumns, 4)) {
+    NS_LOG_ERROR(file << " is not a binary trace (or has an unsupported version)");
+    return false;
+  }
+
+  m_columns.resize(nColumns);
+  for (auto& column : m_columns) {
+    uint64_t type = 0;
+    uint64_t nameLength = 0;
+    if (!readNumber(m_is, type, 1) || type > TraceWriter::STRING
+        || !readNumber(m_is, nameLength, 2)) {
+      NS_LOG_ERROR(file << " has a corrupted header");
+      return false;
+    }
+    column.type = static_cast<TraceWriter::ColumnType>(type);
+    column.name.resize(nameLength);
+    if (nameLength > 0 && !m_is.read(&column.name[0], nameLength)) {
+      NS_LOG_ERROR(file << " has a corrupted header");
+      return false;
+    }
+  }
+
+  m_values.resize(m_columns.size());
+  return true;
+}
+
+const std::vector<TraceWriter::Column>&
+TraceReader::GetColumns() const
+{
+  return m_columns;
+}
+
+bool
+TraceReader::Next()
+{
+  if (m_row + 1 < m_nRows) {
+    m_row++;
+    return true;
+  }
+
+  while (ReadChunk()) {
+    if (m_nRows > 0) {
+      m_row = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+double
+TraceReader::GetDouble(size_t column) const
+{
+  NS_ASSERT(m_columns[column].type == TraceWriter::DOUBLE && m_row < m_nRows);
+
+  double value;
+  std::memcpy(&value, &m_values[column][m_row], sizeof(value));
+  return value;
+}
+
+int64_t
+TraceReader::GetInteger(size_t column) const
+{
+  NS_ASSERT(m_columns[column].type == TraceWriter::INTEGER && m_row < m_nRows);
+  return static_cast<int64_t>(m_values[column][m_row]);
+}
+
+const std::string&
+TraceReader::GetString(size_t column) const
+{
+  NS_ASSERT(m_columns[column].type == TraceWriter::STRING && m_row < m_nRows);
+  return m_strings[m_values[column][m_row]];
+}
+
+void
+TraceReader::PrintHeader(std::ostream& os, char separator/* = ','*/) const
+{
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    if (i > 0) {
+      os << separator;
+    }
+    os << m_columns[i].name;
+  }
+  os << "\n";
+}
+
+void
+TraceReader::PrintRow(std::ostream& os, char separator/* = ','*/) const
+{
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    if (i > 0) {
+      os << separator;
+    }
+
+    switch (m_columns[i].type) {
+    case TraceWriter::DOUBLE:
+      os << GetDouble(i);
+      break;
+    case TraceWriter::INTEGER:
+      os << GetInteger(i);
+      break;
+    case TraceWriter::STRING: {
+      const std::string& value = GetString(i);
+      if (value.find_first_of(std::string(1, separator) + "\"\n") == std::string::npos) {
+        os << value;
+      }
+      else {
+        os << '"';
+        for (char c : value) {
+          if (c == '"') {
+            os << '"';
+          }
+          os << c;
+        }
+        os << '"';
+      }
+      break;
+    }
+    }
+  }
+  os << "\n";
+}
+
+bool
+TraceReader::ConvertToCsv(const std::string& file, std::ostream& os, char separator/* = ','*/)
+{
+  TraceReader reader;
+  if (!reader.Open(file)) {
+    return false;
+  }
+
+  reader.PrintHeader(os, separator);
+  while (reader.Next()) {
+    reader.PrintRow(os, separator);
+  }
+  return !reader.m_isCorrupted;
+}
+
+bool
+TraceReader::ReadStrings()
+{
+  uint64_t nStrings = 0;
+  if (!readNumber(m_is, nStrings, 4)) {
+    return false;
+  }
+
+  for (uint64_t i = 0; i < nStrings; i++) {
+    uint64_t length = 0;
+    if (!readNumber(m_is, length, 4)) {
+      return false;
+    }
+    std::string str(length, '\0');
+    if (length > 0 && !m_is.read(&str[0], length)) {
+      return false;
+    }
+    m_strings.push_back(str);
+  }
+  return true;
+}
+
+bool
+TraceReader::ReadChunk()
+{
+  m_nRows = 0;
+  m_row = 0;
+  if (m_isCorrupted) {
+    return false;
+  }
+
+  int blockType = m_is.get();
+  if (blockType == std::char_traits<char>::eof()) {
+    return false;
+  }
+
+  if (blockType == 'S') {
+    if (!ReadStrings()) {
+      NS_LOG_WARN("Trace is truncated");
+      m_isCorrupted = true;
+      return false;
+    }
+    return true;
+  }
+
+  uint64_t nRows = 0;
+  uint64_t encoding = 0;
+  if (blockType != 'C' || !readNumber(m_is, nRows, 4) || !readNumber(m_is, encoding, 1)
+      || encoding > TraceWriter::PACKED) {
+    NS_LOG_WARN("Trace is corrupted");
+    m_isCorrupted = true;
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    uint64_t size = 0;
+    if (!readNumber(m_is, size, 4)) {
+      m_isCorrupted = true;
+      return false;
+    }
+    data.resize(size);
+    if (size > 0 && !m_is.read(reinterpret_cast<char*>(data.data()), size)) {
+      m_isCorrupted = true;
+      return false;
+    }
+
+    m_values[i].resize(nRows);
+    bool isOk = false;
+    if (encoding == TraceWriter::RAW && m_columns[i].type == TraceWriter::STRING) {
+      isOk = unpackRaw<uint32_t>(data, nRows, m_values[i]);
+    }
+    else if (encoding == TraceWriter::RAW) {
+      isOk = unpackRaw<uint64_t>(data, nRows, m_values[i]);
+    }
+    else {
+      isOk = m_columns[i].type == TraceWriter::DOUBLE ? unpackDoubles(data, nRows, m_values[i])
+                                                      : unpackIntegers(data, nRows, m_values[i]);
+    }
+
+    if (m_columns[i].type == TraceWriter::STRING) {
+      for (uint64_t index : m_values[i]) {
+        isOk = isOk && index < m_strings.size();
+      }
+    }
+
+    if (!isOk) {
+      NS_LOG_WARN("Column " << m_columns[i].name << " is corrupted");
+      m_isCorrupted = true;
+      return false;
+    }
+  }
+
+  m_nRows = nRows;
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
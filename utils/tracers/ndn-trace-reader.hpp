@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_READER_H
+#define NDN_TRACE_READER_H
+
+#include "ndn-trace-writer.hpp"
+
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of binary traces written by TraceWriter
+ *
+ * Example:
+ *
+ *     TraceReader reader;
+ *     if (reader.Open("rate-trace.ndntrace")) {
+ *       while (reader.Next()) {
+ *         double time = reader.GetDouble(0);
+ *         ...
+ *       }
+ *     }
+ */
+class TraceReader {
+public:
+  TraceReader();
+
+  /**
+   * @brief Open the trace and read its schema
+   * @return false if file cannot be opened or is not a binary trace
+   */
+  bool
+  Open(const std::string& file);
+
+  const std::vector<TraceWriter::Column>&
+  GetColumns() const;
+
+  /**
+   * @brief Advance to the next row (the first call advances to the first row)
+   * @return false if there are no more rows or the rest of the file is corrupted
+   */
+  bool
+  Next();
+
+  /**
+   * @brief Get value of DOUBLE column of the current row
+   */
+  double
+  GetDouble(size_t column) const;
+
+  /**
+   * @brief Get value of INTEGER column of the current row
+   */
+  int64_t
+  GetInteger(size_t column) const;
+
+  /**
+   * @brief Get value of STRING column of the current row
+   */
+  const std::string&
+  GetString(size_t column) const;
+
+  /**
+   * @brief Print names of the columns, separated by @p separator
+   */
+  void
+  PrintHeader(std::ostream& os, char separator = ',') const;
+
+  /**
+   * @brief Print the current row, numbers are formatted the same way as in text traces
+   *
+   * Strings that contain the separator, a quote or a newline are quoted.
+   */
+  void
+  PrintRow(std::ostream& os, char separator = ',') const;
+
+  /**
+   * @brief Convert the whole binary trace to CSV
+   * @return false if the file cannot be read completely
+   */
+  static bool
+  ConvertToCsv(const std::string& file, std::ostream& os, char separator = ',');
+
+private:
+  bool
+  ReadChunk();
+
+  bool
+  ReadStrings();
+
+private:
+  std::ifstream m_is;
+  std::vector<TraceWriter::Column> m_columns;
+  std::vector<std::string> m_strings;
+
+  std::vector<std::vector<uint64_t>> m_values; ///< values of the current chunk, per column
+  size_t m_nRows;
+  size_t m_row;
+  bool m_isCorrupted;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_READER_H
@@ -0,0 +1,413 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-writer.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+const char TraceWriter::MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+
+static void
+writeNumber(std::ostream& os, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    os.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+static void
+appendVarNumber(std::vector<uint8_t>& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Pack integers as zigzag encoded differences between consecutive values
+ */
+template<class T>
+static void
+packIntegers(const std::vector<uint8_t>& raw, std::vector<uint8_t>& out)
+{
+  int64_t previous = 0;
+  for (size_t offset = 0; offset + sizeof(T) <= raw.size(); offset += sizeof(T)) {
+    T value;
+    std::memcpy(&value, &raw[offset], sizeof(T));
+
+    int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(value) - previous);
+    appendVarNumber(out, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+    previous = static_cast<int64_t>(value);
+  }
+}
+
+/**
+ * @brief Pack doubles as XOR with the previous value, keeping only the bytes in between the
+ *        leading and trailing zero bytes of the result
+ *
+ * Each value is a control byte (number of leading zero bytes in the high nibble, number of
+ * trailing zero bytes in the low nibble) followed by the remaining bytes, most significant
+ * first.  Repeated values take a single byte.
+ */
+static void
+packDoubles(const std::vector<uint8_t>& raw, std::vector<uint8_t>& out)
+{
+  uint64_t previous = 0;
+  for (size_t offset = 0; offset + sizeof(uint64_t) <= raw.size(); offset += sizeof(uint64_t)) {
+    uint64_t bits;
+    std::memcpy(&bits, &raw[offset], sizeof(bits));
+
+    uint64_t x = bits ^ previous;
+    previous = bits;
+    if (x == 0) {
+      out.push_back(8 << 4);
+      continue;
+    }
+
+    int leading = __builtin_clzll(x) / 8;
+    int trailing = __builtin_ctzll(x) / 8;
+    out.push_back(static_cast<uint8_t>(leading << 4 | trailing));
+    for (int byte = 7 - leading; byte >= trailing; byte--) {
+      out.push_back(static_cast<uint8_t>(x >> (8 * byte)));
+    }
+  }
+}
+
+TraceWriter::ChunkQueue::ChunkQueue()
+  : m_head(new Node)
+  , m_tail(m_head)
+{
+  m_head->next.store(nullptr, std::memory_order_relaxed);
+}
+
+TraceWriter::ChunkQueue::~ChunkQueue()
+{
+  while (m_head != nullptr) {
+    Node* next = m_head->next.load(std::memory_order_relaxed);
+    delete m_head;
+    m_head = next;
+  }
+}
+
+void
+TraceWriter::ChunkQueue::push(std::unique_ptr<Chunk> chunk)
+{
+  Node* node = new Node;
+  node->chunk = std::move(chunk);
+  node->next.store(nullptr, std::memory_order_relaxed);
+
+  m_tail->next.store(node, std::memory_order_release);
+  m_tail = node;
+}
+
+std::unique_ptr<TraceWriter::Chunk>
+TraceWriter::ChunkQueue::pop()
+{
+  Node* next = m_head->next.load(std::memory_order_acquire);
+  if (next == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<Chunk> chunk = std::move(next->chunk);
+  delete m_head;
+  m_head = next;
+  return chunk;
+}
+
+bool
+TraceWriter::ChunkQueue::empty() const
+{
+  return m_head->next.load(std::memory_order_acquire) == nullptr;
+}
+
+TraceWriter::TraceWriter(const std::string& file, const std::vector<Column>& columns,
+                         Encoding encoding/* = PACKED*/, size_t chunkSize/* = 4096*/)
+  : m_columns(columns)
+  , m_encoding(encoding)
+  , m_chunkSize(chunkSize)
+  , m_column(0)
+  , m_isClosing(false)
+{
+  NS_ASSERT(!m_columns.empty() && m_chunkSize > 0);
+
+  m_os.open(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!m_os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  m_os.write(MAGIC, sizeof(MAGIC));
+  writeNumber(m_os, FORMAT_VERSION, 4);
+  writeNumber(m_os, m_columns.size(), 4);
+  for (const auto& column : m_columns) {
+    writeNumber(m_os, column.type, 1);
+    writeNumber(m_os, column.name.size(), 2);
+    m_os.write(column.name.data(), column.name.size());
+  }
+
+  m_chunk = NewChunk();
+  m_thread = std::thread(&TraceWriter::Run, this);
+}
+
+TraceWriter::~TraceWriter()
+{
+  Close();
+}
+
+bool
+TraceWriter::IsOpen() const
+{
+  return m_chunk != nullptr;
+}
+
+const std::vector<TraceWriter::Column>&
+TraceWriter::GetColumns() const
+{
+  return m_columns;
+}
+
+bool
+TraceWriter::IsBinaryFile(const std::string& file)
+{
+  return boost::algorithm::ends_with(file, ".ndntrace");
+}
+
+void
+TraceWriter::Close()
+{
+  if (!IsOpen()) {
+    return;
+  }
+
+  if (m_column != 0) {
+    NS_LOG_WARN("Incomplete row is discarded");
+    for (size_t i = 0; i < m_column; i++) {
+      m_chunk->columns[i].resize(m_chunk->nRows * (m_columns[i].type == STRING ? 4 : 8));
+    }
+    m_column = 0;
+  }
+
+  Flush();
+  m_chunk.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isClosing = true;
+  }
+  m_hasChunks.notify_one();
+  m_thread.join();
+  m_os.close();
+}
+
+TraceWriter&
+TraceWriter::operator<<(double value)
+{
+  if (!IsOpen()) {
+    return *this;
+  }
+
+  NS_ASSERT_MSG(m_columns[m_column].type == DOUBLE,
+                "Column " << m_columns[m_column].name << " is not DOUBLE");
+  PutRaw(&value, sizeof(value));
+  EndValue();
+  return *this;
+}
+
+TraceWriter&
+TraceWriter::PutInteger(int64_t value)
+{
+  if (!IsOpen()) {
+    return *this;
+  }
+
+  if (m_columns[m_column].type == DOUBLE) {
+    return *this << static_cast<double>(value);
+  }
+
+  NS_ASSERT_MSG(m_columns[m_column].type == INTEGER,
+                "Column " << m_columns[m_column].name << " is not INTEGER");
+  PutRaw(&value, sizeof(value));
+  EndValue();
+  return *this;
+}
+
+TraceWriter&
+TraceWriter::operator<<(const std::string& value)
+{
+  if (!IsOpen()) {
+    return *this;
+  }
+
+  NS_ASSERT_MSG(m_columns[m_column].type == STRING,
+                "Column " << m_columns[m_column].name << " is not STRING");
+
+  uint32_t index;
+  auto i = m_strings.find(value);
+  if (i != m_strings.end()) {
+    index = i->second;
+  }
+  else {
+    index = m_strings.size();
+    m_strings.insert(std::make_pair(value, index));
+    m_chunk->newStrings.push_back(value);
+  }
+
+  PutRaw(&index, sizeof(index));
+  EndValue();
+  return *this;
+}
+
+TraceWriter&
+TraceWriter::operator<<(const char* value)
+{
+  return *this << std::string(value);
+}
+
+void
+TraceWriter::PutRaw(const void* value, size_t size)
+{
+  std::vector<uint8_t>& column = m_chunk->columns[m_column];
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(value);
+  column.insert(column.end(), bytes, bytes + size);
+}
+
+void
+TraceWriter::EndValue()
+{
+  if (++m_column < m_columns.size()) {
+    return;
+  }
+
+  m_column = 0;
+  if (++m_chunk->nRows >= m_chunkSize) {
+    Flush();
+  }
+}
+
+std::unique_ptr<TraceWriter::Chunk>
+TraceWriter::NewChunk() const
+{
+  std::unique_ptr<Chunk> chunk(new Chunk);
+  chunk->nRows = 0;
+  chunk->columns.resize(m_columns.size());
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    chunk->columns[i].reserve(m_chunkSize * (m_columns[i].type == STRING ? 4 : 8));
+  }
+  return chunk;
+}
+
+void
+TraceWriter::Flush()
+{
+  if (m_chunk->nRows == 0 && m_chunk->newStrings.empty()) {
+    return;
+  }
+
+  {
+    // push under the lock, so the notification cannot fall between the writer thread checking
+    // the queue and going to sleep
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push(std::move(m_chunk));
+  }
+  m_hasChunks.notify_one();
+  m_chunk = NewChunk();
+}
+
+void
+TraceWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_hasChunks.wait(lock, [this] { return !m_queue.empty() || m_isClosing; });
+    bool isClosing = m_isClosing;
+    lock.unlock();
+
+    // the lock is not held while writing, so the simulation thread never waits for the disk
+    std::unique_ptr<Chunk> chunk;
+    while ((chunk = m_queue.pop()) != nullptr) {
+      WriteChunk(*chunk);
+    }
+
+    if (isClosing) {
+      // all chunks were pushed before the flag was set and have been written
+      break;
+    }
+    lock.lock();
+  }
+
+  m_os.flush();
+}
+
+void
+TraceWriter::WriteChunk(Chunk& chunk)
+{
+  if (!chunk.newStrings.empty()) {
+    m_os.put('S');
+    writeNumber(m_os, chunk.newStrings.size(), 4);
+    for (const auto& str : chunk.newStrings) {
+      writeNumber(m_os, str.size(), 4);
+      m_os.write(str.data(), str.size());
+    }
+  }
+
+  if (chunk.nRows == 0) {
+    return;
+  }
+
+  m_os.put('C');
+  writeNumber(m_os, chunk.nRows, 4);
+  writeNumber(m_os, m_encoding, 1);
+
+  std::vector<uint8_t> packed;
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    const std::vector<uint8_t>* data = &chunk.columns[i];
+    if (m_encoding == PACKED) {
+      packed.clear();
+      switch (m_columns[i].type) {
+      case DOUBLE:
+        packDoubles(chunk.columns[i], packed);
+        break;
+      case INTEGER:
+        packIntegers<int64_t>(chunk.columns[i], packed);
+        break;
+      case STRING:
+        packIntegers<uint32_t>(chunk.columns[i], packed);
+        break;
+      }
+      data = &packed;
+    }
+
+    writeNumber(m_os, data->size(), 4);
+    m_os.write(reinterpret_cast<const char*>(data->data()), data->size());
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_WRITER_H
+#define NDN_TRACE_WRITER_H
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Binary columnar trace output shared by the tracers
+ *
+ * Rows have a fixed schema (a list of named DOUBLE, INTEGER, and STRING columns) and are
+ * written value by value with operator<<, in the same order as the text tracers print them.
+ * Values are appended to per-column buffers, strings are replaced by indexes in a dictionary.
+ * Every ChunkSize rows, the buffers are handed over to a background thread through a
+ * lock-free queue, so the simulation thread never formats text or waits for the disk.  The
+ * background thread sleeps until a chunk arrives, optionally packs the columns (delta encoded
+ * integers, XOR encoded doubles) and writes them to the file.
+ *
+ * Tracers write binary traces when the output file name ends with ".ndntrace".  Use
+ * TraceReader (or the ndn-trace-to-csv tool) to convert the trace to CSV.
+ *
+ * File layout (numbers are little-endian):
+ *
+ *     "NDNTRACE" version:u32 nColumns:u32 { type:u8 nameLength:u16 name }*
+ *     { 'S' nStrings:u32 { length:u32 string }*                              -- new strings
+ *     | 'C' nRows:u32 encoding:u8 { size:u32 column-data }* }*               -- chunk of rows
+ *
+ * RAW column data are doubles, int64 values, and uint32 string indexes in host byte order.
+ * PACKED integer and string columns are zigzag encoded deltas stored as 7-bit groups, PACKED
+ * double columns are described in the writer implementation.
+ */
+class TraceWriter : boost::noncopyable {
+public:
+  enum ColumnType { DOUBLE = 0, INTEGER = 1, STRING = 2 };
+
+  enum Encoding { RAW = 0, PACKED = 1 };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  static const uint32_t FORMAT_VERSION = 1;
+  static const char MAGIC[8];
+
+  /**
+   * @brief Open the trace file and start the background writer thread
+   * @param file output file name
+   * @param columns schema of the trace
+   * @param encoding whether columns are packed before they are written
+   * @param chunkSize number of rows per chunk
+   */
+  TraceWriter(const std::string& file, const std::vector<Column>& columns,
+              Encoding encoding = PACKED, size_t chunkSize = 4096);
+
+  /**
+   * @brief Flush all rows and close the file (see Close)
+   */
+  ~TraceWriter();
+
+  /**
+   * @brief Check if the file has been successfully opened
+   */
+  bool
+  IsOpen() const;
+
+  /**
+   * @brief Flush all rows, wait for the background thread and close the file
+   */
+  void
+  Close();
+
+  const std::vector<Column>&
+  GetColumns() const;
+
+  /**
+   * @brief Check if trace should be written in binary format, based on the file name
+   */
+  static bool
+  IsBinaryFile(const std::string& file);
+
+  TraceWriter&
+  operator<<(double value);
+
+  TraceWriter&
+  operator<<(const std::string& value);
+
+  TraceWriter&
+  operator<<(const char* value);
+
+  template<class T>
+  typename std::enable_if<std::is_integral<T>::value, TraceWriter&>::type
+  operator<<(T value)
+  {
+    return PutInteger(static_cast<int64_t>(value));
+  }
+
+private:
+  struct Chunk {
+    uint32_t nRows;
+    std::vector<std::vector<uint8_t>> columns;
+    std::vector<std::string> newStrings; ///< dictionary additions, sent before the rows
+  };
+
+  /**
+   * @brief Unbounded single-producer single-consumer queue of chunks
+   */
+  class ChunkQueue {
+  public:
+    ChunkQueue();
+    ~ChunkQueue();
+
+    /// called only by the simulation thread
+    void
+    push(std::unique_ptr<Chunk> chunk);
+
+    /// called only by the writer thread, returns nullptr if the queue is empty
+    std::unique_ptr<Chunk>
+    pop();
+
+    /// called only by the writer thread
+    bool
+    empty() const;
+
+  private:
+    struct Node {
+      std::unique_ptr<Chunk> chunk;
+      std::atomic<Node*> next;
+    };
+
+    Node* m_head; ///< consumer end, a node whose chunk has been already taken
+    Node* m_tail; ///< producer end
+  };
+
+  TraceWriter&
+  PutInteger(int64_t value);
+
+  void
+  PutRaw(const void* value, size_t size);
+
+  void
+  EndValue();
+
+  std::unique_ptr<Chunk>
+  NewChunk() const;
+
+  void
+  Flush();
+
+  void
+  Run();
+
+  void
+  WriteChunk(Chunk& chunk);
+
+private:
+  std::vector<Column> m_columns;
+  Encoding m_encoding;
+  size_t m_chunkSize;
+
+  std::ofstream m_os;
+  std::unique_ptr<Chunk> m_chunk;
+  size_t m_column;
+  std::unordered_map<std::string, uint32_t> m_strings;
+
+  ChunkQueue m_queue;
+  std::mutex m_mutex; ///< guards m_isClosing and orders pushes with the writer going to sleep
+  std::condition_variable m_hasChunks;
+  bool m_isClosing;
+  std::thread m_thread;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_WRITER_H